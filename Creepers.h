@@ -11,19 +11,12 @@
 #ifndef INCLUDE_G35_PROGRAMS_CREEPERS_H
 #define INCLUDE_G35_PROGRAMS_CREEPERS_H
 
-#include <LightProgram.h>
-#include <Worm.h>
+#include <Inchworm.h>
 
 // Inchworm with Halloween colors. :|
-class Creepers : public LightProgram {
+class Creepers : public Inchworm {
  public:
   Creepers(G35& g35);
-  uint32_t Do();
-
- private:
-  uint8_t count_;
-  uint32_t next_worm_;
-  Worm worms_[6];
 };
 
 #endif  // INCLUDE_G35_PROGRAMS_CREEPERS_H
@@ -10,11 +10,14 @@
 
 #include <Cylon.h>
 
-Cylon::Cylon(G35& g35) : LightProgram(g35), orbiter_(0.5, 0.01), last_x_(0) {}
+Cylon::Cylon(G35& g35)
+  : LightProgram(g35),
+    orbiter_(Q8_8(0.5), ANGLE(0.01), random_.max_color()),
+    last_x_(0) {}
 
 uint32_t Cylon::Do() {
   orbiter_.Do();
-  uint8_t x = orbiter_.x_local(light_count_, light_count_ >> 1);
+  uint16_t x = orbiter_.x_local(light_count_, light_count_ >> 1);
 
   if (last_x_ != x) {
     g35_.set_color(last_x_, 255, COLOR_BLACK);
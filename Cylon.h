@@ -22,7 +22,7 @@ class Cylon : public LightProgram {
 
  private:
   Orbiter orbiter_;
-  uint8_t last_x_;
+  uint16_t last_x_;
 };
 
 #endif  // INCLUDE_G35_PROGRAMS_CYLON_H
@@ -10,37 +10,66 @@
 
 #include <Eyes.h>
 
-Eyes::Eyes(G35& g35) : LightProgram(g35), count_(0), next_eye_(0) {
-  g35_.fill_color(0, light_count_, 255, COLOR_BLACK);
-
-  while (3 * EYE_COUNT >= light_count_) {
-    // There isn't enough room on the light string for this many eyes.
-  }
-
-  for (int i = 0; i < EYE_COUNT; ++i) {
-    uint16_t new_position;
+Eyes::Eyes(G35& g35)
+  : LightProgram(g35),
+    sprites_(g35, SpriteEngine::capacity_for(light_count_, BULBS_PER_EYE)),
+    count_(0), next_eye_(0) {
+  // Each eye needs its two bulbs and a dark one beside them, which there's
+  // always room for with one eye per BULBS_PER_EYE bulbs. The eyes wait,
+  // dead, until Do() opens them.
+  for (uint8_t i = 0; i < sprites_.get_capacity(); ++i) {
+    int16_t new_position;
     do {
-      new_position = rand() % (light_count_ - 1);
-      for (int j = 0; j < i; ++j) {
-        uint16_t occupied_position = eyes_[j].get_position();
-        if (new_position >= occupied_position - 1 &&
-            new_position <= occupied_position + 1) {
-          new_position = light_count_;
+      new_position = random_.uniform(light_count_ - 1);
+      for (uint8_t j = 0; j < i; ++j) {
+        int16_t occupied_position = G35Math::to_int(sprites_.get_position(j));
+        if (new_position >= occupied_position - 2 &&
+            new_position <= occupied_position + 2) {
+          new_position = -1;
           break;
         }
       }
-    } while (new_position == light_count_);
-    eyes_[i].set_position(new_position);
+    } while (new_position < 0);
+    sprites_.set_position(i, G35Math::from_int(new_position));
+    sprites_.set_length(i, Q8_8_ONE);
+    switch (random_.uniform(4)) {
+    case 0: sprites_.set_color(i, COLOR_ORANGE); break;
+    case 1: sprites_.set_color(i, COLOR_RED); break;
+    case 2: sprites_.set_color(i, COLOR_INDIGO); break;
+    case 3: sprites_.set_color(i, COLOR_GREEN); break;
+    }
   }
 }
 
 uint32_t Eyes::Do() {
-  for (int i = 0; i < count_; ++i) {
-    eyes_[i].Do(g35_);
+  sprites_.update();
+  for (uint8_t i = 0; i < count_; ++i) {
+    if (!sprites_.is_alive(i)) {
+      blink(i);
+    }
   }
-  if (count_ < EYE_COUNT && millis() > next_eye_) {
+  sprites_.draw();
+
+  uint8_t capacity = sprites_.get_capacity();
+  if (count_ < capacity && G35Clock::now() > next_eye_) {
+    // Closed for now, so that it opens with a blink.
+    sprites_.set_lifetime(count_, frames(100));
     ++count_;
-    next_eye_ = millis() + 2000 + 1000 * count_;
+    next_eye_ = G35Clock::now() + 2000 + 10000UL * count_ / capacity;
   }
   return bulb_frame_;
 }
+
+void Eyes::blink(uint8_t i) {
+  if (sprites_.get_flags(i) & SpriteEngine::VISIBLE) {
+    sprites_.set_flags(i, 0);
+    sprites_.set_lifetime(i, frames(100));
+  } else {
+    sprites_.set_flags(i, SpriteEngine::VISIBLE);
+    sprites_.set_lifetime(i, frames(3000 + random_.uniform(3000)));
+  }
+}
+
+uint16_t Eyes::frames(uint16_t ms) {
+  return ms / (bulb_frame_ > 0 ? bulb_frame_ : 1) + 1;
+}
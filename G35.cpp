@@ -12,11 +12,13 @@
 */
 
 #include <G35.h>
+#include <G35ColorTables.h>
+#include <G35Random.h>
 
 G35::G35() : light_count_(0) {
 }
 
-bool G35::set_color_if_in_range(uint8_t position, uint8_t intensity,
+bool G35::set_color_if_in_range(uint16_t position, uint8_t intensity,
                                 color_t color) {
   if (position >= light_count_) {
     return false;
@@ -30,103 +32,216 @@ color_t G35::color(uint8_t r, uint8_t g, uint8_t b) {
   return COLOR(r, g, b);
 }
 
+static const color_t HUE_TABLE[HUE_MAX + 1] PROGMEM = {
+  G35_TABLE_16(g35_hue_color, 0), G35_TABLE_16(g35_hue_color, 16),
+  G35_TABLE_16(g35_hue_color, 32), G35_TABLE_16(g35_hue_color, 48),
+  G35_TABLE_16(g35_hue_color, 64), G35_TABLE_16(g35_hue_color, 80),
+};
+
 color_t G35::color_hue(uint8_t h) {
-  switch (h >> 4) {
-  case 0:     h -= 0; return color(h, CHANNEL_MAX, 0);
-  case 1:     h -= 16; return color(CHANNEL_MAX, (CHANNEL_MAX - h), 0);
-  case 2:     h -= 32; return color(CHANNEL_MAX, 0, h);
-  case 3:     h -= 48; return color((CHANNEL_MAX - h), 0, CHANNEL_MAX);
-  case 4:     h -= 64; return color(0, h, CHANNEL_MAX);
-  case 5:     h -= 80; return color(0, CHANNEL_MAX, (CHANNEL_MAX - h));
-  default:
+  if (h > HUE_MAX) {
     return COLOR_WHITE;
   }
+  return pgm_read_word(&HUE_TABLE[h]);
 }
 
-void G35::fill_color(uint8_t begin, uint8_t count,
-                     uint8_t intensity, color_t color) {
+void G35::set_colors(uint16_t begin, uint16_t count,
+                     const color_t* colors, const uint8_t* intensities) {
   while (count--) {
-    set_color(begin++, intensity, color);
+    set_color(begin++, *intensities++, *colors++);
   }
 }
 
-void G35::fill_random_max(uint8_t begin, uint8_t count, uint8_t intensity) {
+void G35::set_commands(uint16_t begin, uint16_t count,
+                       const command_t* commands) {
   while (count--) {
-    set_color(begin++, intensity, max_color(rand()));
+    command_t command = *commands++;
+    set_color(begin++, COMMAND_INTENSITY(command), COMMAND_COLOR(command));
   }
 }
 
-void G35::fill_sequence(uint8_t begin, uint8_t count,
-                        uint16_t sequence, uint8_t span_size,
+// static
+bool G35::is_solid(uint16_t count, const color_t* colors,
+                   const uint8_t* intensities) {
+  for (uint16_t i = 1; i < count; ++i) {
+    if (colors[i] != colors[0] || intensities[i] != intensities[0]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void G35::fill_color(uint16_t begin, uint16_t count,
+                     uint8_t intensity, color_t color) {
+  if (begin == 0 && count >= light_count_ && fill_all(intensity, color)) {
+    return;
+  }
+  color_t colors[FILL_CHUNK];
+  uint8_t intensities[FILL_CHUNK];
+  uint8_t chunk = count < FILL_CHUNK ? count : FILL_CHUNK;
+  for (uint8_t i = 0; i < chunk; ++i) {
+    colors[i] = color;
+    intensities[i] = intensity;
+  }
+  while (count > 0) {
+    chunk = count < FILL_CHUNK ? count : FILL_CHUNK;
+    set_colors(begin, chunk, colors, intensities);
+    begin += chunk;
+    count -= chunk;
+  }
+}
+
+void G35::fill_random_max(uint16_t begin, uint16_t count,
+                          uint8_t intensity, G35Random& random) {
+  color_t colors[FILL_CHUNK];
+  uint8_t intensities[FILL_CHUNK];
+  memset(intensities, intensity, sizeof(intensities));
+  while (count > 0) {
+    uint8_t chunk = count < FILL_CHUNK ? count : FILL_CHUNK;
+    for (uint8_t i = 0; i < chunk; ++i) {
+      colors[i] = random.max_color();
+    }
+    set_colors(begin, chunk, colors, intensities);
+    begin += chunk;
+    count -= chunk;
+  }
+}
+
+namespace {
+
+// Walks a sequence downward a bulb at a time, keeping track of which span
+// each bulb is in, and where that span falls in a pattern that repeats every
+// |period| spans. Only starting out takes a division; an AVR has no divide
+// instruction, so dividing for every bulb would cost more than the rest of
+// the fill.
+class SpanWalker {
+ public:
+  SpanWalker(uint16_t sequence, uint16_t span_size, uint8_t period)
+    : span_size_(span_size), period_(period) {
+    start(sequence);
+  }
+
+  // sequence / span_size, and that modulo period.
+  uint16_t get_span() const { return span_; }
+  uint8_t get_phase() const { return phase_; }
+
+  // Moves on to sequence - 1.
+  void step() {
+    if (offset_ > 0) {
+      --offset_;
+    } else if (span_ == 0) {
+      // The sequence wraps around to 0xffff, and so doesn't land at the end
+      // of a span unless span_size happens to divide 0x10000.
+      start(0xffff);
+    } else {
+      --span_;
+      offset_ = span_size_ - 1;
+      phase_ = phase_ == 0 ? period_ - 1 : phase_ - 1;
+    }
+  }
+
+ private:
+  void start(uint16_t sequence) {
+    span_ = sequence / span_size_;
+    offset_ = sequence % span_size_;
+    phase_ = span_ % period_;
+  }
+
+  uint16_t span_size_;
+  uint8_t period_;
+  uint16_t span_;
+  uint16_t offset_;
+  uint8_t phase_;
+};
+
+}  // namespace
+
+// The last bulb of the span gets |sequence|, and the sequence counts up
+// toward the first bulb, which is what makes the chases move forward.
+void G35::fill_sequence(uint16_t begin, uint16_t count,
+                        uint16_t sequence, uint16_t span_size,
                         uint8_t intensity,
                         color_t (*sequence_func)(uint16_t sequence)) {
-  while (count--) {
-    set_color(begin + count, intensity, sequence_func(sequence++ / span_size));
+  color_t colors[FILL_CHUNK];
+  uint8_t intensities[FILL_CHUNK];
+  memset(intensities, intensity, sizeof(intensities));
+  SpanWalker walker(sequence + count - 1, span_size, 1);
+  while (count > 0) {
+    uint8_t chunk = count < FILL_CHUNK ? count : FILL_CHUNK;
+    for (uint8_t i = 0; i < chunk; ++i) {
+      colors[i] = sequence_func(walker.get_span());
+      walker.step();
+    }
+    set_colors(begin, chunk, colors, intensities);
+    begin += chunk;
+    count -= chunk;
   }
 }
 
-void G35::fill_sequence(uint16_t sequence, uint8_t span_size,
+void G35::fill_sequence(uint16_t sequence, uint16_t span_size,
                         uint8_t intensity,
                         color_t (*sequence_func)(uint16_t sequence)) {
   fill_sequence(0, light_count_, sequence, span_size, intensity, sequence_func);
 }
 
-void G35::fill_sequence(uint8_t begin, uint8_t count,
-                        uint16_t sequence, uint8_t span_size,
+void G35::fill_sequence(uint16_t begin, uint16_t count,
+                        uint16_t sequence, uint16_t span_size,
                         bool (*sequence_func)(uint16_t sequence, color_t& color,
                                               uint8_t& intensity)) {
-  while (count--) {
-    color_t color;
-    uint8_t intensity;
-    sequence_func(sequence++ / span_size, color, intensity);
-    set_color(begin + count, intensity, color);
+  color_t colors[FILL_CHUNK];
+  uint8_t intensities[FILL_CHUNK];
+  SpanWalker walker(sequence + count - 1, span_size, 1);
+  while (count > 0) {
+    uint8_t chunk = count < FILL_CHUNK ? count : FILL_CHUNK;
+    for (uint8_t i = 0; i < chunk; ++i) {
+      sequence_func(walker.get_span(), colors[i], intensities[i]);
+      walker.step();
+    }
+    set_colors(begin, chunk, colors, intensities);
+    begin += chunk;
+    count -= chunk;
   }
 }
 
+void G35::fill_sequence(uint16_t begin, uint16_t count,
+                        uint16_t sequence, uint16_t span_size,
+                        const command_t* palette, uint8_t palette_size) {
+  command_t commands[FILL_CHUNK];
+  SpanWalker walker(sequence + count - 1, span_size, palette_size);
+  while (count > 0) {
+    uint8_t chunk = count < FILL_CHUNK ? count : FILL_CHUNK;
+    for (uint8_t i = 0; i < chunk; ++i) {
+      commands[i] = pgm_read_dword(&palette[walker.get_phase()]);
+      walker.step();
+    }
+    set_commands(begin, chunk, commands);
+    begin += chunk;
+    count -= chunk;
+  }
+}
+
+static const color_t RAINBOW_TABLE[G35::RB_COUNT] PROGMEM = {
+  COLOR_RED, COLOR_ORANGE, COLOR_YELLOW, COLOR_GREEN, COLOR_BLUE, COLOR_INDIGO,
+  COLOR_VIOLET,
+};
+
 color_t G35::rainbow_color(uint16_t color) {
   if (color >= RB_COUNT) {
     color = color % RB_COUNT;
   }
-  switch (color) {
-  case RB_RED:
-    return COLOR_RED;
-  case RB_ORANGE:
-    return COLOR_ORANGE;
-  case RB_YELLOW:
-    return COLOR_YELLOW;
-  case RB_GREEN:
-    return COLOR_GREEN;
-  case RB_BLUE:
-    return COLOR_BLUE;
-  case RB_INDIGO:
-    return COLOR_INDIGO;
-  case RB_VIOLET:
-    return COLOR_VIOLET;
-  default:
-    return COLOR_WHITE;
-  }
+  return pgm_read_word(&RAINBOW_TABLE[color]);
 }
 
+static const color_t MAX_COLOR_TABLE[7] PROGMEM = {
+  COLOR_RED, COLOR_GREEN, COLOR_BLUE, COLOR_CYAN, COLOR_MAGENTA, COLOR_YELLOW,
+  COLOR_WHITE,
+};
+
 color_t G35::max_color(uint16_t color) {
   if (color >= 7) {
     color = color % 7;
   }
-  switch (color) {
-  case 0:
-    return COLOR_RED;
-  case 1:
-    return COLOR_GREEN;
-  case 2:
-    return COLOR_BLUE;
-  case 3:
-    return COLOR_CYAN;
-  case 4:
-    return COLOR_MAGENTA;
-  case 5:
-    return COLOR_YELLOW;
-  default:
-    return COLOR_WHITE;
-  }
+  return pgm_read_word(&MAX_COLOR_TABLE[color]);
 }
 
 void G35::broadcast_intensity(uint8_t intensity) {
@@ -33,6 +33,17 @@
 #define COLOR_INDIGO          COLOR(0x6, 0, 0xf)
 #define COLOR_VIOLET          COLOR(0x8, 0, 0xf)
 
+// A command is an intensity and color packed into the low 20 bits of a word,
+// exactly as they go on the wire. Programs that reuse the same few colors can
+// build their commands once and hand them to set_commands().
+#define command_t uint32_t
+#define COMMAND(intensity, color) \
+  (((uint32_t)((intensity) & 0xff) << 12) | ((color) & 0xfff))
+#define COMMAND_INTENSITY(command) ((uint8_t)((command) >> 12))
+#define COMMAND_COLOR(command) ((color_t)((command) & 0xfff))
+
+class G35Random;
+
 // G35 is an abstract class representing a string of G35 lights of arbitrary
 // length. LightPrograms talk to this interface.
 class G35 {
@@ -70,10 +81,21 @@ class G35 {
   virtual uint8_t get_bulb_frame() { return 1000 / get_light_count(); }
 
   // Turn on a specific LED with a color and brightness
-  virtual void set_color(uint8_t bulb, uint8_t intensity, color_t color) = 0;
+  virtual void set_color(uint16_t bulb, uint8_t intensity, color_t color) = 0;
+
+  // Sets |count| bulbs starting at |begin|, bulb i getting colors[i] and
+  // intensities[i]. Implementations override this to avoid the cost of a
+  // set_color() call per bulb, so it's the fastest way to change many bulbs.
+  virtual void set_colors(uint16_t begin, uint16_t count,
+                          const color_t* colors, const uint8_t* intensities);
+
+  // Like set_colors(), but with each bulb's intensity and color already
+  // packed by COMMAND().
+  virtual void set_commands(uint16_t begin, uint16_t count,
+                            const command_t* commands);
 
   // Like set_color, but doesn't explode with positions out of range
-  virtual bool set_color_if_in_range(uint8_t led, uint8_t intensity,
+  virtual bool set_color_if_in_range(uint16_t led, uint8_t intensity,
                                      color_t color);
 
   // Color data type
@@ -88,27 +110,54 @@ class G35 {
   // 0 or 255, except for black). The mapping is arbitary but deterministic.
   static color_t max_color(uint16_t color);
 
+  // Sets every bulb to the same color and intensity in one go, if the
+  // implementation knows a faster way than bulb by bulb. Returns false,
+  // having changed nothing, if it doesn't. fill_color() tries this first
+  // when asked to fill the whole string.
+  virtual bool fill_all(uint8_t intensity, color_t color) { return false; }
+
   // Make all LEDs the same color starting at specified beginning LED
-  virtual void fill_color(uint8_t begin, uint8_t count, uint8_t intensity,
+  virtual void fill_color(uint16_t begin, uint16_t count, uint8_t intensity,
                           color_t color);
-  virtual void fill_random_max(uint8_t begin, uint8_t count, uint8_t intensity);
-
-  virtual void fill_sequence(uint16_t sequence, uint8_t span_size,
+  // Fills with random max colors drawn from |random|.
+  virtual void fill_random_max(uint16_t begin, uint16_t count,
+                               uint8_t intensity, G35Random& random);
+
+  // Fills bulbs in spans of |span_size|, giving each span what
+  // |sequence_func| returns for its span number. See G35.cpp for how the
+  // sequence runs along the string.
+  virtual void fill_sequence(uint16_t sequence, uint16_t span_size,
                              uint8_t intensity,
                              color_t (*sequence_func)(uint16_t sequence));
-  virtual void fill_sequence(uint8_t begin, uint8_t count, uint16_t sequence,
-                             uint8_t span_size, uint8_t intensity,
+  virtual void fill_sequence(uint16_t begin, uint16_t count, uint16_t sequence,
+                             uint16_t span_size, uint8_t intensity,
                              color_t (*sequence_func)(uint16_t sequence));
-  virtual void fill_sequence(uint8_t begin, uint8_t count, uint16_t sequence,
-                             uint8_t span_size,
+  virtual void fill_sequence(uint16_t begin, uint16_t count, uint16_t sequence,
+                             uint16_t span_size,
                              bool (*sequence_func)(uint16_t sequence,
                                                    color_t& color,
                                                    uint8_t& intensity));
+  // Like fill_sequence(), but span n gets palette[n % palette_size]. The
+  // palette index is kept running from bulb to bulb, so this costs no
+  // arithmetic per bulb beyond a counter, and the commands are built ahead
+  // of time. Prefer it for chases whose colors come from a fixed list.
+  // |palette| must be in PROGMEM.
+  virtual void fill_sequence(uint16_t begin, uint16_t count, uint16_t sequence,
+                             uint16_t span_size, const command_t* palette,
+                             uint8_t palette_size);
   virtual void broadcast_intensity(uint8_t intensity);
 
  protected:
   uint16_t light_count_;
 
+  // The fill_*() helpers build spans for set_colors() this many bulbs at a
+  // time, which keeps their stack use small.
+  enum { FILL_CHUNK = 16 };
+
+  // True if the first |count| bulbs of the span are all the same.
+  static bool is_solid(uint16_t count, const color_t* colors,
+                       const uint8_t* intensities);
+
   virtual uint8_t get_broadcast_bulb() = 0;
 };
 
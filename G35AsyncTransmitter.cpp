@@ -0,0 +1,134 @@
+/*
+  G35: An Arduino library for GE Color Effects G-35 holiday lights.
+  Copyright © 2011 The G35 Authors. Use, modification, and distribution are
+  subject to the BSD license as described in the accompanying LICENSE file.
+
+  See README for complete attributions.
+*/
+
+#include <G35AsyncTransmitter.h>
+#include <G35Protocol.h>
+
+G35AsyncTransmitter::Command G35AsyncTransmitter::queue_[QUEUE_SIZE];
+volatile uint8_t G35AsyncTransmitter::head_ = 0;
+volatile uint8_t G35AsyncTransmitter::tail_ = 0;
+volatile bool G35AsyncTransmitter::is_busy_ = false;
+uint8_t G35AsyncTransmitter::overflow_policy_ =
+  G35AsyncTransmitter::BLOCK_WHEN_FULL;
+uint32_t G35AsyncTransmitter::overflow_count_ = 0;
+uint8_t G35AsyncTransmitter::state_ = G35AsyncTransmitter::START;
+uint8_t G35AsyncTransmitter::bits_left_ = 0;
+uint32_t G35AsyncTransmitter::shifter_ = 0;
+bool G35AsyncTransmitter::is_one_ = false;
+
+// static
+bool G35AsyncTransmitter::enqueue(volatile uint8_t* port, uint8_t mask,
+                                  uint32_t frame, const G35Timing* timing) {
+  if (get_queue_depth() == QUEUE_SIZE) {
+    ++overflow_count_;
+    if (overflow_policy_ == DROP_WHEN_FULL) {
+      return false;
+    }
+    while (get_queue_depth() == QUEUE_SIZE) {
+      delayMicroseconds(DELAYSHORT);
+    }
+  }
+
+  Command& command = queue_[tail_ & (QUEUE_SIZE - 1)];
+  command.port = port;
+  command.mask = mask;
+  command.frame = frame;
+  command.timing = timing;
+
+  // The interrupt might be finishing the last command right now, so deciding
+  // whether it needs restarting can't be interrupted.
+  noInterrupts();
+  tail_ = tail_ + 1;
+  if (!is_busy_) {
+    is_busy_ = true;
+    state_ = START;
+    start_timer();
+  }
+  interrupts();
+  return true;
+}
+
+// static
+void G35AsyncTransmitter::flush() {
+  while (get_queue_depth() != 0) {
+    delayMicroseconds(DELAYSHORT);
+  }
+}
+
+// static
+uint16_t G35AsyncTransmitter::on_timer() {
+  Command& command = queue_[head_ & (QUEUE_SIZE - 1)];
+  const G35Timing& timing = *command.timing;
+  switch (state_) {
+  case START:
+    *command.port |= command.mask;
+    shifter_ = command.frame << (32 - G35_FRAME_BITS);
+    bits_left_ = G35_FRAME_BITS;
+    state_ = BIT_LOW;
+    return timing.short_us;
+  case BIT_LOW:
+    *command.port &= ~command.mask;
+    // Testing the top bit and shifting by one is far cheaper on an AVR than
+    // shifting by a variable amount.
+    is_one_ = (shifter_ & 0x80000000) != 0;
+    shifter_ <<= 1;
+    state_ = BIT_HIGH;
+    return is_one_ ? timing.long_us : timing.short_us;
+  case BIT_HIGH:
+    *command.port |= command.mask;
+    state_ = --bits_left_ == 0 ? END : BIT_LOW;
+    return is_one_ ? timing.short_us : timing.long_us;
+  case END:
+    *command.port &= ~command.mask;
+    state_ = QUIET;
+    return timing.end_us;
+  case QUIET:
+  default:
+    head_ = head_ + 1;
+    state_ = START;
+    if (head_ == tail_) {
+      is_busy_ = false;
+      return 0;
+    }
+    return on_timer();
+  }
+}
+
+#if defined(__AVR__)
+
+#define TICKS_PER_MICROSECOND (F_CPU / 1000000UL)
+
+// static
+void G35AsyncTransmitter::start_timer() {
+  // Normal mode, no prescaling. Each compare match moves OCR1A along by the
+  // delay to the next edge, so edges don't drift with interrupt latency.
+  TCCR1A = 0;
+  TCCR1B = _BV(CS10);
+  OCR1A = TCNT1 + DELAYSHORT * TICKS_PER_MICROSECOND;
+  TIFR1 = _BV(OCF1A);
+  TIMSK1 |= _BV(OCIE1A);
+}
+
+// static
+void G35AsyncTransmitter::on_timer_interrupt() {
+  uint16_t next = on_timer();
+  if (next == 0) {
+    TIMSK1 &= ~_BV(OCIE1A);
+  } else {
+    OCR1A += next * TICKS_PER_MICROSECOND;
+  }
+}
+
+#else  // __AVR__
+
+// static
+void G35AsyncTransmitter::start_timer() {
+  host_start_timer(on_timer, DELAYSHORT);
+}
+
+#endif  // __AVR__
@@ -0,0 +1,115 @@
+/*
+  G35: An Arduino library for GE Color Effects G-35 holiday lights.
+  Copyright © 2011 The G35 Authors. Use, modification, and distribution are
+  subject to the BSD license as described in the accompanying LICENSE file.
+
+  See README for complete attributions.
+*/
+
+#ifndef INCLUDE_G35_ASYNC_TRANSMITTER_H
+#define INCLUDE_G35_ASYNC_TRANSMITTER_H
+
+#include <Arduino.h>
+#include <G35Protocol.h>
+
+// G35AsyncTransmitter sends bulb commands from a timer interrupt, so that the
+// sketch can get on with computing the next frame while the current one is
+// on the wire. G35String uses it when put in asynchronous mode with
+// set_async().
+//
+// Commands wait in a small queue, and a state machine driven by Timer1's
+// compare-match interrupt produces one edge per interrupt. Interrupts are only
+// off while the interrupt itself runs, so millis() keeps good time.
+//
+// On AVR this takes over Timer1, which stops analogWrite() on the pins that
+// timer drives and conflicts with libraries such as Servo. The library can't
+// define the interrupt handler itself without breaking those libraries for
+// everyone, so a sketch that uses asynchronous mode must say
+//
+//   G35_ASYNC_ISR();
+//
+// once, outside any function.
+class G35AsyncTransmitter {
+ public:
+  enum {
+    // Commands that can wait at once, including the one being sent. Must be
+    // a power of two.
+    QUEUE_SIZE = 16
+  };
+
+  // What enqueue() does when the queue is full.
+  enum {
+    // Wait for room. Nothing is lost, but the caller stalls.
+    BLOCK_WHEN_FULL,
+    // Give up on the command and return false.
+    DROP_WHEN_FULL,
+  };
+
+  static void set_overflow_policy(uint8_t policy) { overflow_policy_ = policy; }
+
+  // Queues a 26-bit frame (see G35_FRAME()) for the pin with the given
+  // output register and bit, to be sent with |timing|, which must outlive
+  // the frame's time in the queue. Returns false if it was dropped.
+  static bool enqueue(volatile uint8_t* port, uint8_t mask, uint32_t frame,
+                      const G35Timing* timing);
+
+  // Commands queued or being sent.
+  static uint8_t get_queue_depth() { return (uint8_t)(tail_ - head_); }
+
+  // Times enqueue() found the queue full, whatever it did about it.
+  static uint32_t get_overflow_count() { return overflow_count_; }
+
+  // Returns once everything queued so far is on the wire.
+  static void flush();
+
+  // Produces the next edge and returns the number of microseconds until the
+  // one after it, or zero once the queue is empty. The timer interrupt calls
+  // this. So does the host build's simulated timer.
+  static uint16_t on_timer();
+
+#if defined(__AVR__)
+  static void on_timer_interrupt();
+#endif
+
+ private:
+  struct Command {
+    volatile uint8_t* port;
+    uint8_t mask;
+    uint32_t frame;
+    const G35Timing* timing;
+  };
+
+  enum {
+    START,
+    BIT_LOW,
+    BIT_HIGH,
+    END,
+    QUIET,
+  };
+
+  static void start_timer();
+
+  static Command queue_[QUEUE_SIZE];
+  // Free-running counters. The ISR owns head_ and the sketch owns tail_.
+  static volatile uint8_t head_;
+  static volatile uint8_t tail_;
+  static volatile bool is_busy_;
+  static uint8_t overflow_policy_;
+  static uint32_t overflow_count_;
+
+  // The state machine, touched only by on_timer().
+  static uint8_t state_;
+  static uint8_t bits_left_;
+  static uint32_t shifter_;
+  static bool is_one_;
+};
+
+#if defined(__AVR__)
+#define G35_ASYNC_ISR() \
+  ISR(TIMER1_COMPA_vect) { G35AsyncTransmitter::on_timer_interrupt(); }
+#else
+// The host build's simulated timer calls on_timer() directly.
+#define G35_ASYNC_ISR()
+#endif
+
+#endif  // INCLUDE_G35_ASYNC_TRANSMITTER_H
@@ -0,0 +1,119 @@
+/*
+  G35: An Arduino library for GE Color Effects G-35 holiday lights.
+  Copyright © 2011 The G35 Authors. Use, modification, and distribution are
+  subject to the BSD license as described in the accompanying LICENSE file.
+
+  See README for complete attributions.
+*/
+
+#include <G35Blend.h>
+
+namespace {
+
+// Each kernel combines one channel of the picture, |under|, with the same
+// channel of the bulb, |over|, weighed by |weight|.
+struct Over {
+  static uint8_t blend(uint8_t under, uint8_t over, uint8_t weight) {
+    // The two weights add up to 255, so the sum can't overflow.
+    return G35Blend::mul255(over, weight) +
+      G35Blend::mul255(under, 255 - weight);
+  }
+};
+
+struct Add {
+  static uint8_t blend(uint8_t under, uint8_t over, uint8_t weight) {
+    uint16_t sum = under + G35Blend::mul255(over, weight);
+    return sum > 255 ? 255 : sum;
+  }
+};
+
+struct Max {
+  static uint8_t blend(uint8_t under, uint8_t over, uint8_t weight) {
+    uint8_t lit = G35Blend::mul255(over, weight);
+    return lit > under ? lit : under;
+  }
+};
+
+struct Multiply {
+  static uint8_t blend(uint8_t under, uint8_t over, uint8_t weight) {
+    // At zero weight the filter is white, and lets everything through.
+    return G35Blend::mul255(under,
+                            255 - G35Blend::mul255(255 - over, weight));
+  }
+};
+
+// A channel of a color, 0 to CHANNEL_MAX, as a light level.
+uint8_t channel_level(uint8_t channel) {
+  return channel * 17;
+}
+
+// The planes never overlap the bulbs being blended in, and saying so with
+// __restrict__ is what lets the compiler vectorize the loop.
+template <typename Kernel>
+void blend_planes(uint8_t* __restrict__ red, uint8_t* __restrict__ green,
+                  uint8_t* __restrict__ blue,
+                  const color_t* __restrict__ colors,
+                  const uint8_t* __restrict__ intensities,
+                  const uint8_t* __restrict__ alphas,
+                  uint8_t opacity, uint16_t count) {
+  for (uint16_t i = 0; i < count; ++i) {
+    color_t color = colors[i];
+    uint8_t level = G35Blend::intensity_to_level(intensities[i]);
+    uint8_t weight = G35Blend::mul255(alphas[i], opacity);
+    red[i] = Kernel::blend(
+      red[i], G35Blend::mul255(channel_level(color & 0xf), level), weight);
+    green[i] = Kernel::blend(
+      green[i], G35Blend::mul255(channel_level((color >> 4) & 0xf), level),
+      weight);
+    blue[i] = Kernel::blend(
+      blue[i], G35Blend::mul255(channel_level((color >> 8) & 0xf), level),
+      weight);
+  }
+}
+
+}  // namespace
+
+// static
+void G35Blend::blend(uint8_t mode, uint8_t* red, uint8_t* green,
+                     uint8_t* blue, const color_t* colors,
+                     const uint8_t* intensities, const uint8_t* alphas,
+                     uint8_t opacity, uint16_t count) {
+  switch (mode) {
+  case ADD:
+    blend_planes<Add>(red, green, blue, colors, intensities, alphas, opacity,
+                      count);
+    break;
+  case MAX:
+    blend_planes<Max>(red, green, blue, colors, intensities, alphas, opacity,
+                      count);
+    break;
+  case MULTIPLY:
+    blend_planes<Multiply>(red, green, blue, colors, intensities, alphas,
+                           opacity, count);
+    break;
+  default:
+    blend_planes<Over>(red, green, blue, colors, intensities, alphas, opacity,
+                       count);
+    break;
+  }
+}
+
+// static
+void G35Blend::to_command(uint8_t red, uint8_t green, uint8_t blue,
+                          color_t* color, uint8_t* intensity) {
+  uint8_t brightest = red > green ? red : green;
+  if (blue > brightest) {
+    brightest = blue;
+  }
+  if (brightest == 0) {
+    *color = COLOR_BLACK;
+    *intensity = G35::MAX_INTENSITY;
+    return;
+  }
+  // The one division per bulb, with 12 fractional bits. No channel is
+  // brighter than |brightest|, so each product still fits in 16 bits.
+  uint16_t scale = (CHANNEL_MAX << 12) / brightest;
+  *color = COLOR((red * scale + 2048) >> 12, (green * scale + 2048) >> 12,
+                 (blue * scale + 2048) >> 12);
+  *intensity = mul255(brightest, G35::MAX_INTENSITY);
+}
@@ -0,0 +1,62 @@
+/*
+  G35: An Arduino library for GE Color Effects G-35 holiday lights.
+  Copyright © 2011 The G35 Authors. Use, modification, and distribution are
+  subject to the BSD license as described in the accompanying LICENSE file.
+
+  See README for complete attributions.
+*/
+
+#ifndef INCLUDE_G35_BLEND_H
+#define INCLUDE_G35_BLEND_H
+
+#include <G35.h>
+
+// Fixed-point kernels that blend bulbs into a picture, for G35Compositor.
+//
+// The picture is kept as light: one plane per channel, each bulb 0 (dark)
+// to 255 (channel at 15 and full intensity). Bulbs to blend in come as the
+// color and intensity a program set, plus an alpha, 0 (transparent) to 255
+// (opaque). Everything is 8-bit values with 16-bit products, which an AVR
+// multiplies in hardware. Each kernel is one loop over plain arrays with no
+// branches in it, so that on a desktop the compiler can vectorize it, for
+// previewing layouts of thousands of bulbs.
+class G35Blend {
+ public:
+  // Blend modes. Each weighs the bulb by its alpha times the layer's
+  // opacity, so a transparent bulb leaves the picture alone.
+  enum {
+    // Covers the picture.
+    OVER,
+    // Adds its light to the picture's.
+    ADD,
+    // Keeps whichever is brighter, channel by channel.
+    MAX,
+    // Filters the picture's light through its own, so that white leaves it
+    // alone and black darkens it.
+    MULTIPLY,
+  };
+
+  // a * b / 255, rounded.
+  static uint8_t mul255(uint8_t a, uint8_t b) {
+    uint16_t product = (uint16_t)a * b + 128;
+    return (product + (product >> 8)) >> 8;
+  }
+
+  // G35 intensities run to G35::MAX_INTENSITY. Light levels run to 255.
+  static uint8_t intensity_to_level(uint8_t intensity) {
+    return (intensity * 5) >> 2;
+  }
+
+  // Blends |count| bulbs into the planes with |mode|.
+  static void blend(uint8_t mode, uint8_t* red, uint8_t* green,
+                    uint8_t* blue, const color_t* colors,
+                    const uint8_t* intensities, const uint8_t* alphas,
+                    uint8_t opacity, uint16_t count);
+
+  // Turns one bulb's light back into a color and intensity. The brightest
+  // channel sets the intensity, so dim light keeps its hue.
+  static void to_command(uint8_t red, uint8_t green, uint8_t blue,
+                         color_t* color, uint8_t* intensity);
+};
+
+#endif  // INCLUDE_G35_BLEND_H
@@ -0,0 +1,18 @@
+/*
+  G35: An Arduino library for GE Color Effects G-35 holiday lights.
+  Copyright © 2011 The G35 Authors. Use, modification, and distribution are
+  subject to the BSD license as described in the accompanying LICENSE file.
+
+  See README for complete attributions.
+*/
+
+#include <G35Clock.h>
+
+static G35SystemClock system_clock;
+
+G35Clock* G35Clock::current_ = &system_clock;
+
+// static
+void G35Clock::set_current(G35Clock* clock) {
+  current_ = clock != NULL ? clock : &system_clock;
+}
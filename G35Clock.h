@@ -0,0 +1,69 @@
+/*
+  G35: An Arduino library for GE Color Effects G-35 holiday lights.
+  Copyright © 2011 The G35 Authors. Use, modification, and distribution are
+  subject to the BSD license as described in the accompanying LICENSE file.
+
+  See README for complete attributions.
+*/
+
+#ifndef INCLUDE_G35_CLOCK_H
+#define INCLUDE_G35_CLOCK_H
+
+#include <Arduino.h>
+
+// Where ProgramRunner, ProgramScheduler and the light programs get the time.
+//
+// Normally that's the board's own millis() and delay(). Installing a
+// G35VirtualClock instead lets a host program run a show as fast as the CPU
+// allows: nothing sleeps, and time jumps straight to the next deadline, so an
+// hour of show takes a moment and comes out the same on every run.
+class G35Clock {
+ public:
+  virtual ~G35Clock() {}
+
+  virtual uint32_t millis() = 0;
+  virtual void delay(uint32_t ms) = 0;
+
+  // The clock everything reads right now.
+  static G35Clock* get_current() { return current_; }
+
+  // Makes |clock| current, or the board's clock again if it's NULL.
+  static void set_current(G35Clock* clock);
+
+  // Shorthand for get_current()->millis(), for programs.
+  static uint32_t now() { return current_->millis(); }
+
+ private:
+  static G35Clock* current_;
+};
+
+// The board's millis() and delay(). This is the clock unless you install
+// another one.
+class G35SystemClock : public G35Clock {
+ public:
+  virtual uint32_t millis() { return ::millis(); }
+  virtual void delay(uint32_t ms) { ::delay(ms); }
+};
+
+// A clock that only moves when it's told to. delay() returns at once, having
+// moved the clock along by |ms|.
+class G35VirtualClock : public G35Clock {
+ public:
+  G35VirtualClock(uint32_t start = 0) : now_(start) {}
+
+  virtual uint32_t millis() { return now_; }
+  virtual void delay(uint32_t ms) { now_ += ms; }
+
+  // Moves the clock to |deadline|, for example ProgramRunner's
+  // get_next_deadline(), unless it's already there or past it.
+  void advance_to(uint32_t deadline) {
+    if ((int32_t)(deadline - now_) > 0) {
+      now_ = deadline;
+    }
+  }
+
+ private:
+  uint32_t now_;
+};
+
+#endif  // INCLUDE_G35_CLOCK_H
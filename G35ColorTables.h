@@ -0,0 +1,67 @@
+/*
+  G35: An Arduino library for GE Color Effects G-35 holiday lights.
+  Copyright © 2011 The G35 Authors. Use, modification, and distribution are
+  subject to the BSD license as described in the accompanying LICENSE file.
+
+  See README for complete attributions.
+*/
+
+#ifndef INCLUDE_G35_COLOR_TABLES_H
+#define INCLUDE_G35_COLOR_TABLES_H
+
+#include <G35.h>
+
+// The formulas behind the library's fixed palettes. Each is evaluated only by
+// the compiler, to fill a PROGMEM table, so at run time a palette lookup is a
+// single read with no division or branching. Read entries with
+// pgm_read_word().
+
+// Expands to |f|(base), |f|(base + 1), ... |f|(base + 15), for spelling out
+// table initializers.
+#define G35_TABLE_16(f, base)                                           \
+  f((base) + 0), f((base) + 1), f((base) + 2), f((base) + 3),           \
+  f((base) + 4), f((base) + 5), f((base) + 6), f((base) + 7),           \
+  f((base) + 8), f((base) + 9), f((base) + 10), f((base) + 11),         \
+  f((base) + 12), f((base) + 13), f((base) + 14), f((base) + 15)
+
+// A channel that rises through each 16-step section of a palette, and one
+// that falls.
+constexpr uint8_t g35_ramp_up(uint8_t i) { return i % 16; }
+constexpr uint8_t g35_ramp_down(uint8_t i) { return CHANNEL_MAX - i % 16; }
+
+// G35::color_hue(): six sections around the color wheel.
+constexpr color_t g35_hue_color(uint8_t h) {
+  return
+    h < 16 ? COLOR(g35_ramp_up(h), CHANNEL_MAX, 0) :
+    h < 32 ? COLOR(CHANNEL_MAX, g35_ramp_down(h), 0) :
+    h < 48 ? COLOR(CHANNEL_MAX, 0, g35_ramp_up(h)) :
+    h < 64 ? COLOR(g35_ramp_down(h), 0, CHANNEL_MAX) :
+    h < 80 ? COLOR(0, g35_ramp_up(h), CHANNEL_MAX) :
+    COLOR(0, CHANNEL_MAX, g35_ramp_down(h));
+}
+
+// Rainbow's 48-step wheel: red to green to blue and back to red.
+constexpr color_t g35_wheel_color(uint8_t i) {
+  return
+    i < 16 ? COLOR(g35_ramp_down(i), g35_ramp_up(i), 0) :
+    i < 32 ? COLOR(0, g35_ramp_down(i), g35_ramp_up(i)) :
+    COLOR(g35_ramp_up(i), 0, g35_ramp_down(i));
+}
+
+// Rainbow's 32-step lines, which go from one primary to another and back.
+constexpr color_t g35_line_rg_color(uint8_t i) {
+  return i < 16 ? COLOR(g35_ramp_down(i), g35_ramp_up(i), 0) :
+    COLOR(g35_ramp_up(i), g35_ramp_down(i), 0);
+}
+
+constexpr color_t g35_line_gb_color(uint8_t i) {
+  return i < 16 ? COLOR(0, g35_ramp_down(i), g35_ramp_up(i)) :
+    COLOR(0, g35_ramp_up(i), g35_ramp_down(i));
+}
+
+constexpr color_t g35_line_br_color(uint8_t i) {
+  return i < 16 ? COLOR(g35_ramp_up(i), 0, g35_ramp_down(i)) :
+    COLOR(g35_ramp_down(i), 0, g35_ramp_up(i));
+}
+
+#endif  // INCLUDE_G35_COLOR_TABLES_H
@@ -0,0 +1,115 @@
+/*
+  G35: An Arduino library for GE Color Effects G-35 holiday lights.
+  Copyright © 2011 The G35 Authors. Use, modification, and distribution are
+  subject to the BSD license as described in the accompanying LICENSE file.
+
+  See README for complete attributions.
+*/
+
+#include <G35Compositor.h>
+
+G35Layer::G35Layer()
+  : colors_(NULL), intensities_(NULL), alphas_(NULL),
+    blend_mode_(G35Blend::OVER), opacity_(255), is_dirty_(false) {
+}
+
+void G35Layer::set_color(uint16_t bulb, uint8_t intensity, color_t color) {
+  if (bulb >= light_count_) {
+    return;
+  }
+  colors_[bulb] = color;
+  intensities_[bulb] = intensity > MAX_INTENSITY ? MAX_INTENSITY : intensity;
+  alphas_[bulb] = color == COLOR_BLACK ? 0 : 255;
+  is_dirty_ = true;
+}
+
+void G35Layer::set_colors(uint16_t begin, uint16_t count,
+                          const color_t* colors, const uint8_t* intensities) {
+  while (count--) {
+    set_color(begin++, *intensities++, *colors++);
+  }
+}
+
+bool G35Layer::fill_all(uint8_t intensity, color_t color) {
+  if (intensity > MAX_INTENSITY) {
+    intensity = MAX_INTENSITY;
+  }
+  for (uint16_t i = 0; i < light_count_; ++i) {
+    colors_[i] = color;
+  }
+  memset(intensities_, intensity, light_count_);
+  memset(alphas_, color == COLOR_BLACK ? 0 : 255, light_count_);
+  is_dirty_ = true;
+  return true;
+}
+
+void G35Layer::broadcast_intensity(uint8_t intensity) {
+  // Like a real string, every bulb takes on the intensity and keeps its
+  // color.
+  if (intensity > MAX_INTENSITY) {
+    intensity = MAX_INTENSITY;
+  }
+  memset(intensities_, intensity, light_count_);
+  is_dirty_ = true;
+}
+
+G35Compositor::G35Compositor(G35& output, uint16_t light_count,
+                             G35Layer* layers, uint8_t layer_count,
+                             uint8_t* planes)
+  : output_(output), light_count_(light_count), layers_(layers),
+    layer_count_(layer_count),
+    red_(planes), green_(planes + light_count),
+    blue_(planes + 2 * light_count), shown_red_(planes + 3 * light_count),
+    shown_green_(planes + 4 * light_count),
+    shown_blue_(planes + 5 * light_count), is_synced_(false) {
+}
+
+void G35Compositor::attach_layer(uint8_t layer, color_t* colors,
+                                 uint8_t* intensities, uint8_t* alphas) {
+  G35Layer& l = layers_[layer];
+  l.light_count_ = light_count_;
+  l.colors_ = colors;
+  l.intensities_ = intensities;
+  l.alphas_ = alphas;
+  memset(intensities, G35::MAX_INTENSITY, light_count_);
+  memset(alphas, 0, light_count_);
+  for (uint16_t i = 0; i < light_count_; ++i) {
+    colors[i] = COLOR_BLACK;
+  }
+}
+
+void G35Compositor::loop() {
+  bool is_dirty = !is_synced_;
+  for (uint8_t i = 0; i < layer_count_; ++i) {
+    is_dirty |= layers_[i].is_dirty_;
+    layers_[i].is_dirty_ = false;
+  }
+  if (!is_dirty) {
+    return;
+  }
+
+  memset(red_, 0, light_count_);
+  memset(green_, 0, light_count_);
+  memset(blue_, 0, light_count_);
+  for (uint8_t i = 0; i < layer_count_; ++i) {
+    G35Layer& layer = layers_[i];
+    G35Blend::blend(layer.blend_mode_, red_, green_, blue_, layer.colors_,
+                    layer.intensities_, layer.alphas_, layer.opacity_,
+                    light_count_);
+  }
+
+  for (uint16_t i = 0; i < light_count_; ++i) {
+    if (is_synced_ && red_[i] == shown_red_[i] &&
+        green_[i] == shown_green_[i] && blue_[i] == shown_blue_[i]) {
+      continue;
+    }
+    color_t color;
+    uint8_t intensity;
+    G35Blend::to_command(red_[i], green_[i], blue_[i], &color, &intensity);
+    output_.set_color(i, intensity, color);
+    shown_red_[i] = red_[i];
+    shown_green_[i] = green_[i];
+    shown_blue_[i] = blue_[i];
+  }
+  is_synced_ = true;
+}
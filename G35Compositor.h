@@ -0,0 +1,126 @@
+/*
+  G35: An Arduino library for GE Color Effects G-35 holiday lights.
+  Copyright © 2011 The G35 Authors. Use, modification, and distribution are
+  subject to the BSD license as described in the accompanying LICENSE file.
+
+  See README for complete attributions.
+*/
+
+#ifndef INCLUDE_G35_COMPOSITOR_H
+#define INCLUDE_G35_COMPOSITOR_H
+
+#include <G35.h>
+#include <G35Blend.h>
+
+class G35Compositor;
+
+// An off-screen string for one light program to draw on. It remembers each
+// bulb's color and intensity, plus an alpha: bulbs the program has lit are
+// opaque, and black ones (including any it never set) are transparent, so
+// that the layers below show through. A G35Compositor blends it with the
+// others onto a real string.
+class G35Layer : public G35 {
+ public:
+  G35Layer();
+
+  virtual uint16_t get_light_count() { return light_count_; }
+  virtual void set_color(uint16_t bulb, uint8_t intensity, color_t color);
+  virtual void set_colors(uint16_t begin, uint16_t count,
+                          const color_t* colors, const uint8_t* intensities);
+  virtual bool fill_all(uint8_t intensity, color_t color);
+  virtual void broadcast_intensity(uint8_t intensity);
+
+  // How the layer blends onto the ones below it: one of G35Blend's modes.
+  // It starts out as G35Blend::OVER.
+  void set_blend_mode(uint8_t mode) { blend_mode_ = mode; is_dirty_ = true; }
+  uint8_t get_blend_mode() const { return blend_mode_; }
+
+  // Scales every bulb's alpha, from 0 (the layer doesn't show) to 255 (it
+  // starts out at 255).
+  void set_opacity(uint8_t opacity) { opacity_ = opacity; is_dirty_ = true; }
+  uint8_t get_opacity() const { return opacity_; }
+
+ protected:
+  // Unused, since broadcast_intensity() is overridden.
+  virtual uint8_t get_broadcast_bulb() { return 0; }
+
+ private:
+  friend class G35Compositor;
+
+  color_t* colors_;
+  uint8_t* intensities_;
+  uint8_t* alphas_;
+  uint8_t blend_mode_;
+  uint8_t opacity_;
+  // Whether anything has changed since the compositor last looked.
+  bool is_dirty_;
+};
+
+// Runs several light programs on one string at once, such as Twinkle on top
+// of a chase. Each program gets a G35Layer of its own to draw on, in place
+// of the string. loop() blends the layers, bottom first, and sends only the
+// bulbs whose blended color changed.
+//
+// Declare a StaticG35Compositor, which sets the memory aside at compile
+// time, and give each ProgramRunner's programs a different layer. Call
+// loop() as often as the runners' loop(). Each layer takes four bytes a bulb,
+// and the compositor six more.
+class G35Compositor {
+ public:
+  uint8_t get_layer_count() const { return layer_count_; }
+
+  // Layer 0 is at the bottom.
+  G35Layer& get_layer(uint8_t layer) { return layers_[layer]; }
+
+  // If any layer has changed since the last call, blends them all and sends
+  // the bulbs that changed.
+  void loop();
+
+ protected:
+  // |planes| has room for six bytes a bulb.
+  G35Compositor(G35& output, uint16_t light_count, G35Layer* layers,
+                uint8_t layer_count, uint8_t* planes);
+
+  // Gives |layer| its memory: a color, an intensity and an alpha per bulb.
+  void attach_layer(uint8_t layer, color_t* colors, uint8_t* intensities,
+                    uint8_t* alphas);
+
+ private:
+  G35& output_;
+  uint16_t light_count_;
+  G35Layer* layers_;
+  uint8_t layer_count_;
+  // The picture being blended, and the one on the string, as light levels
+  // (see G35Blend).
+  uint8_t* red_;
+  uint8_t* green_;
+  uint8_t* blue_;
+  uint8_t* shown_red_;
+  uint8_t* shown_green_;
+  uint8_t* shown_blue_;
+  // False until the first loop() has set every bulb, since the string's
+  // state isn't known before then.
+  bool is_synced_;
+};
+
+// A G35Compositor of |LAYER_COUNT| layers for a string of |LIGHT_COUNT|
+// bulbs. Declare it at file scope.
+template <uint16_t LIGHT_COUNT, uint8_t LAYER_COUNT>
+class StaticG35Compositor : public G35Compositor {
+ public:
+  StaticG35Compositor(G35& output)
+    : G35Compositor(output, LIGHT_COUNT, layers_, LAYER_COUNT, planes_[0]) {
+    for (uint8_t i = 0; i < LAYER_COUNT; ++i) {
+      attach_layer(i, colors_[i], intensities_[i], alphas_[i]);
+    }
+  }
+
+ private:
+  G35Layer layers_[LAYER_COUNT];
+  color_t colors_[LAYER_COUNT][LIGHT_COUNT];
+  uint8_t intensities_[LAYER_COUNT][LIGHT_COUNT];
+  uint8_t alphas_[LAYER_COUNT][LIGHT_COUNT];
+  uint8_t planes_[6][LIGHT_COUNT];
+};
+
+#endif  // INCLUDE_G35_COMPOSITOR_H
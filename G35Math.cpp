@@ -0,0 +1,53 @@
+/*
+  G35: An Arduino library for GE Color Effects G-35 holiday lights.
+  Copyright © 2011 The G35 Authors. Use, modification, and distribution are
+  subject to the BSD license as described in the accompanying LICENSE file.
+
+  See README for complete attributions.
+*/
+
+#include <G35Math.h>
+
+// The first quarter turn of sin(), 64 steps to the quarter plus the end
+// point, scaled so that 1.0 is 65536. 65536 itself doesn't fit, so the last
+// entry is a hair short.
+static const uint16_t SINE_TABLE[65] PROGMEM = {
+  0, 1608, 3216, 4821, 6424, 8022, 9616, 11204,
+  12785, 14359, 15924, 17479, 19024, 20557, 22078, 23586,
+  25080, 26558, 28020, 29466, 30893, 32303, 33692, 35062,
+  36410, 37736, 39040, 40320, 41576, 42806, 44011, 45190,
+  46341, 47464, 48559, 49624, 50660, 51665, 52639, 53581,
+  54491, 55368, 56212, 57022, 57798, 58538, 59244, 59914,
+  60547, 61145, 61705, 62228, 62714, 63162, 63572, 63944,
+  64277, 64571, 64827, 65043, 65220, 65358, 65457, 65516,
+  65535,
+};
+
+// static
+q16_16_t G35Math::mul(q16_16_t a, q16_16_t b) {
+  // Four 16x16-bit products, which an AVR has hardware for, rather than one
+  // 32x32-bit product into 64 bits, which it would do in software.
+  int16_t a_high = a >> 16;
+  int16_t b_high = b >> 16;
+  uint16_t a_low = a & 0xffff;
+  uint16_t b_low = b & 0xffff;
+  return (int32_t)a_high * b_high * 65536 + (int32_t)a_high * b_low +
+    (int32_t)a_low * b_high + (int32_t)(((uint32_t)a_low * b_low) >> 16);
+}
+
+// static
+q16_16_t G35Math::sin(angle_t angle) {
+  // The other three quarters are reflections of the first.
+  uint16_t offset = angle & 0x3fff;
+  if (angle & 0x4000) {
+    offset = 0x4000 - offset;
+  }
+  uint8_t index = offset >> 8;
+  uint8_t fraction = offset & 0xff;
+  int32_t value = pgm_read_word(&SINE_TABLE[index]);
+  if (fraction != 0) {
+    int32_t next = pgm_read_word(&SINE_TABLE[index + 1]);
+    value += ((next - value) * fraction) >> 8;
+  }
+  return angle & 0x8000 ? -value : value;
+}
@@ -0,0 +1,59 @@
+/*
+  G35: An Arduino library for GE Color Effects G-35 holiday lights.
+  Copyright © 2011 The G35 Authors. Use, modification, and distribution are
+  subject to the BSD license as described in the accompanying LICENSE file.
+
+  See README for complete attributions.
+*/
+
+#ifndef INCLUDE_G35_MATH_H
+#define INCLUDE_G35_MATH_H
+
+#include <Arduino.h>
+
+// Fixed-point arithmetic for light programs. An AVR has no floating-point
+// hardware, so a float multiply or sin() costs hundreds of cycles, which adds
+// up quickly inside a frame. These do the same jobs with integer operations.
+//
+// q8_8_t has 8 integer and 8 fractional bits, which suits small factors like
+// speeds and radii. q16_16_t has 16 and 16, which is enough for positions on
+// the longest string group. Angles are binary: a full turn is 65536, so they
+// wrap around for free.
+
+typedef int16_t q8_8_t;
+typedef int32_t q16_16_t;
+typedef uint16_t angle_t;
+
+// Conversions from constants. Don't use these with variables, or the float
+// arithmetic comes right back.
+#define Q8_8(x) ((q8_8_t)((x) * 256.0 + ((x) < 0 ? -0.5 : 0.5)))
+#define Q16_16(x) ((q16_16_t)((x) * 65536.0 + ((x) < 0 ? -0.5 : 0.5)))
+#define ANGLE(radians) \
+  ((angle_t)(int32_t)((radians) * 65536.0 / (2 * PI) + \
+                      ((radians) < 0 ? -0.5 : 0.5)))
+
+#define Q8_8_ONE ((q8_8_t)0x100)
+#define Q16_16_ONE ((q16_16_t)0x10000)
+
+class G35Math {
+ public:
+  static q16_16_t from_int(int16_t i) { return (q16_16_t)i * 65536; }
+
+  // Rounds toward negative infinity, like floor().
+  static int16_t to_int(q16_16_t x) { return x >> 16; }
+
+  static q16_16_t from_q8_8(q8_8_t x) { return (q16_16_t)x * 256; }
+
+  static q16_16_t mul(q16_16_t a, q16_16_t b);
+
+  // Both return values in [-1.0, 1.0], accurate to about 1/10000.
+  static q16_16_t sin(angle_t angle);
+  static q16_16_t cos(angle_t angle) { return sin(angle + 0x4000); }
+
+  // Returns |a| when |t| is 0, moving toward |b| as |t| grows toward 65536.
+  static q16_16_t lerp(q16_16_t a, q16_16_t b, uint16_t t) {
+    return a + mul(b - a, t);
+  }
+};
+
+#endif  // INCLUDE_G35_MATH_H
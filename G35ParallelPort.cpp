@@ -0,0 +1,280 @@
+/*
+  G35: An Arduino library for GE Color Effects G-35 holiday lights.
+  Copyright © 2011 The G35 Authors. Use, modification, and distribution are
+  subject to the BSD license as described in the accompanying LICENSE file.
+
+  See README for complete attributions.
+*/
+
+#include <G35ParallelPort.h>
+#include <G35Protocol.h>
+#include <G35Stats.h>
+
+G35ParallelString::G35ParallelString(uint8_t pin, uint8_t light_count,
+                                     uint8_t physical_light_count,
+                                     uint8_t bulb_zero, bool is_forward)
+: G35(), pin_(pin), physical_light_count_(physical_light_count),
+  bulb_zero_(bulb_zero), is_forward_(is_forward), next_dirty_(0),
+  pending_broadcast_(NO_BROADCAST), pending_broadcast_color_(COLOR_BLACK) {
+  light_count_ = light_count;
+  for (uint8_t i = 0; i < MAX_BULBS; ++i) {
+    colors_[i] = COLOR_BLACK;
+  }
+  memset(intensities_, UNKNOWN_INTENSITY, sizeof(intensities_));
+  memset(dirty_, 0, sizeof(dirty_));
+}
+
+G35ParallelString::G35ParallelString(uint8_t pin, uint8_t light_count)
+: G35(), pin_(pin), physical_light_count_(light_count),
+  bulb_zero_(0), is_forward_(true), next_dirty_(0),
+  pending_broadcast_(NO_BROADCAST), pending_broadcast_color_(COLOR_BLACK) {
+  light_count_ = light_count;
+  for (uint8_t i = 0; i < MAX_BULBS; ++i) {
+    colors_[i] = COLOR_BLACK;
+  }
+  memset(intensities_, UNKNOWN_INTENSITY, sizeof(intensities_));
+  memset(dirty_, 0, sizeof(dirty_));
+}
+
+void G35ParallelString::set_color(uint16_t bulb, uint8_t intensity,
+                                  color_t color) {
+  uint8_t address = bulb == BROADCAST_BULB ?
+    BROADCAST_BULB : (bulb + bulb_zero_) & BROADCAST_BULB;
+
+  if (intensity > MAX_INTENSITY) {
+    intensity = MAX_INTENSITY;
+  }
+
+  if (address == BROADCAST_BULB) {
+    // The broadcast goes out before any bulb changes queued alongside it, so
+    // those bulbs need to pick up its effects now. See G35String::set_color()
+    // for what a broadcast does.
+    for (uint8_t i = 0; i < MAX_BULBS; ++i) {
+      if (color != COLOR_BLACK) {
+        colors_[i] = color;
+        intensities_[i] = intensity;
+      } else if (intensities_[i] != UNKNOWN_INTENSITY) {
+        intensities_[i] = intensity;
+      }
+    }
+    if (color != COLOR_BLACK) {
+      // It paints over every change queued so far.
+      memset(dirty_, 0, sizeof(dirty_));
+      pending_broadcast_color_ = color;
+    } else if (pending_broadcast_ == NO_BROADCAST) {
+      pending_broadcast_color_ = COLOR_BLACK;
+    }
+    pending_broadcast_ = intensity;
+    return;
+  }
+  if (intensities_[address] == intensity && colors_[address] == color) {
+    G35_STATS_SKIPPED_BULB();
+    return;
+  }
+  intensities_[address] = intensity;
+  colors_[address] = color;
+  dirty_[address >> 3] |= 1 << (address & 7);
+}
+
+void G35ParallelString::set_colors(uint16_t begin, uint16_t count,
+                                   const color_t* colors,
+                                   const uint8_t* intensities) {
+  if (begin == 0 && count >= light_count_ &&
+      is_solid(count, colors, intensities) &&
+      fill_all(intensities[0], colors[0])) {
+    return;
+  }
+  while (count--) {
+    G35ParallelString::set_color(begin++, *intensities++, *colors++);
+  }
+}
+
+bool G35ParallelString::fill_all(uint8_t intensity, color_t color) {
+  // Same rules as G35String::fill_all().
+  if (bulb_zero_ != 0 || physical_light_count_ != light_count_) {
+    return false;
+  }
+  if (color == COLOR_BLACK) {
+    for (uint8_t i = 0; i < physical_light_count_; ++i) {
+      if (intensities_[i] == UNKNOWN_INTENSITY ||
+          (intensities_[i] != 0 && colors_[i] != COLOR_BLACK)) {
+        G35ParallelString::set_color(BROADCAST_BULB, 0, COLOR_BLACK);
+        return true;
+      }
+    }
+    return true;
+  }
+  if (intensity > MAX_INTENSITY) {
+    intensity = MAX_INTENSITY;
+  }
+  for (uint8_t i = 0; i < physical_light_count_; ++i) {
+    if (intensities_[i] != intensity || colors_[i] != color) {
+      G35ParallelString::set_color(BROADCAST_BULB, intensity, color);
+      return true;
+    }
+  }
+  return true;
+}
+
+bool G35ParallelString::next_frame(uint32_t* frame) {
+  if (pending_broadcast_ != NO_BROADCAST) {
+    *frame = G35_FRAME(BROADCAST_BULB, pending_broadcast_,
+                       pending_broadcast_color_);
+    pending_broadcast_ = NO_BROADCAST;
+    return true;
+  }
+  // Pick up where the last search left off, skipping clean bytes whole.
+  for (uint8_t searched = 0; searched < MAX_BULBS; ) {
+    uint8_t address = next_dirty_;
+    uint8_t bit = 1 << (address & 7);
+    if (dirty_[address >> 3] == 0) {
+      uint8_t skip = 8 - (address & 7);
+      searched += skip;
+      next_dirty_ = address + skip;
+    } else {
+      ++searched;
+      ++next_dirty_;
+    }
+    if (next_dirty_ >= MAX_BULBS) {
+      next_dirty_ = 0;
+    }
+    if (dirty_[address >> 3] & bit) {
+      dirty_[address >> 3] &= ~bit;
+      *frame = G35_FRAME(address, intensities_[address], colors_[address]);
+      return true;
+    }
+  }
+  return false;
+}
+
+uint8_t G35ParallelString::enumeration_address(uint8_t index) {
+  return bulb_zero_ + (is_forward_ ? index : light_count_ - 1 - index);
+}
+
+G35ParallelPort::G35ParallelPort()
+: string_count_(0), port_number_(NOT_A_PORT), port_(NULL),
+  timing_(G35_STANDARD_TIMING) {}
+
+bool G35ParallelPort::AddString(G35ParallelString* string) {
+  if (string_count_ == MAX_STRINGS) {
+    return false;
+  }
+  uint8_t port_number = digitalPinToPort(string->pin_);
+  uint8_t bit_mask = digitalPinToBitMask(string->pin_);
+  if (port_number == NOT_A_PORT) {
+    return false;
+  }
+  if (string_count_ > 0 && port_number != port_number_) {
+    return false;
+  }
+  for (uint8_t i = 0; i < string_count_; ++i) {
+    if (bit_masks_[i] == bit_mask) {
+      return false;
+    }
+  }
+  pinMode(string->pin_, OUTPUT);
+  port_number_ = port_number;
+  port_ = portOutputRegister(port_number);
+  strings_[string_count_] = string;
+  bit_masks_[string_count_] = bit_mask;
+  ++string_count_;
+  return true;
+}
+
+void G35ParallelPort::enumerate() {
+  uint32_t frames[MAX_STRINGS];
+  for (uint8_t index = 0; ; ++index) {
+    uint8_t active = 0;
+    for (uint8_t i = 0; i < string_count_; ++i) {
+      G35ParallelString* string = strings_[i];
+      if (index < string->physical_light_count_) {
+        uint8_t address = string->enumeration_address(index);
+        frames[i] = G35_FRAME(address, G35::MAX_INTENSITY, COLOR_RED);
+        active |= 1 << i;
+
+        // Remember what the bulb now shows, as G35String would.
+        address &= G35ParallelString::BROADCAST_BULB;
+        if (address != G35ParallelString::BROADCAST_BULB) {
+          string->intensities_[address] = G35::MAX_INTENSITY;
+          string->colors_[address] = COLOR_RED;
+        }
+      }
+    }
+    if (active == 0) {
+      break;
+    }
+    send_frames(active, frames);
+  }
+}
+
+void G35ParallelPort::show() {
+  uint32_t frames[MAX_STRINGS];
+  for (;;) {
+    uint8_t active = 0;
+    for (uint8_t i = 0; i < string_count_; ++i) {
+      if (strings_[i]->next_frame(&frames[i])) {
+        active |= 1 << i;
+      }
+    }
+    if (active == 0) {
+      break;
+    }
+    send_frames(active, frames);
+  }
+}
+
+void G35ParallelPort::send_frames(uint8_t active, const uint32_t* frames) {
+  // Slice the frames into port values ahead of time, so that the only work
+  // between edges is a single port write.
+  uint8_t ones[G35_FRAME_BITS];
+  uint8_t pins = 0;
+  uint8_t bulbs = 0;
+  memset(ones, 0, sizeof(ones));
+  for (uint8_t i = 0; i < string_count_; ++i) {
+    if (!(active & (1 << i))) {
+      continue;
+    }
+    uint8_t bit_mask = bit_masks_[i];
+    uint32_t frame = frames[i];
+    pins |= bit_mask;
+    ++bulbs;
+    for (int8_t bit = G35_FRAME_BITS - 1; bit >= 0; --bit) {
+      if (frame & 1) {
+        ones[bit] |= bit_mask;
+      }
+      frame >>= 1;
+    }
+  }
+  G35_STATS_INTERRUPTS_OFF();
+  send(pins, ones);
+  G35_STATS_INTERRUPTS_ON(bulbs);
+}
+
+void G35ParallelPort::send(uint8_t active, const uint8_t* ones) {
+  volatile uint8_t* port = port_;
+  const uint8_t* end = ones + G35_FRAME_BITS;
+  const uint8_t short_us = timing_.short_us;
+  const uint8_t long_minus_short_us = timing_.long_us - timing_.short_us;
+
+  noInterrupts();
+
+  *port |= active;
+  delayMicroseconds(short_us);
+
+  // Every bit starts with all pins low. Pins sending a zero come back up
+  // after the short delay, and the rest after the long one.
+  while (ones != end) {
+    const uint8_t zeros = active & ~*ones++;
+    *port &= ~active;
+    delayMicroseconds(short_us);
+    *port |= zeros;
+    delayMicroseconds(long_minus_short_us);
+    *port |= active;
+    delayMicroseconds(short_us);
+  }
+
+  *port &= ~active;
+  delayMicroseconds(timing_.end_us);
+
+  interrupts();
+}
@@ -0,0 +1,119 @@
+/*
+  G35: An Arduino library for GE Color Effects G-35 holiday lights.
+  Copyright © 2011 The G35 Authors. Use, modification, and distribution are
+  subject to the BSD license as described in the accompanying LICENSE file.
+
+  See README for complete attributions.
+*/
+
+#ifndef INCLUDE_G35_PARALLEL_PORT_H
+#define INCLUDE_G35_PARALLEL_PORT_H
+
+#include <G35.h>
+#include <G35Protocol.h>
+
+// A G35ParallelString is one light string driven by a G35ParallelPort. It
+// looks like any other G35 to a LightProgram, but set_color() only records
+// what each bulb should show. Nothing reaches the wire until the port's
+// show() method runs.
+class G35ParallelString : public G35 {
+ public:
+  // Arguments are the same as G35String's.
+  G35ParallelString(uint8_t pin, uint8_t light_count,
+                    uint8_t physical_light_count, uint8_t bulb_zero,
+                    bool is_forward);
+  G35ParallelString(uint8_t pin, uint8_t light_count);
+
+  // Implementation of G35 interface.
+  virtual uint16_t get_light_count() { return light_count_; }
+  void set_color(uint16_t bulb, uint8_t intensity, color_t color);
+  void set_colors(uint16_t begin, uint16_t count,
+                  const color_t* colors, const uint8_t* intensities);
+  bool fill_all(uint8_t intensity, color_t color);
+
+ protected:
+  virtual uint8_t get_broadcast_bulb() { return BROADCAST_BULB; }
+
+ private:
+  friend class G35ParallelPort;
+
+  enum {
+    BROADCAST_BULB = 63,
+    MAX_BULBS = BROADCAST_BULB,
+    DIRTY_BYTES = (MAX_BULBS + 7) / 8,
+    UNKNOWN_INTENSITY = 0xff,
+    NO_BROADCAST = 0xff,
+  };
+
+  // Stores the next command this string needs to send in |frame|, or
+  // returns false if it's up to date.
+  bool next_frame(uint32_t* frame);
+
+  // Returns the address of the |index|th bulb to enumerate.
+  uint8_t enumeration_address(uint8_t index);
+
+  uint8_t pin_;
+  uint8_t physical_light_count_;
+  uint8_t bulb_zero_;
+  bool is_forward_;
+
+  // What each bulb should be showing, indexed by wire address, and which of
+  // them haven't been sent yet.
+  color_t colors_[MAX_BULBS];
+  uint8_t intensities_[MAX_BULBS];
+  uint8_t dirty_[DIRTY_BYTES];
+  uint8_t next_dirty_;
+
+  // A broadcast waiting to go out, or NO_BROADCAST.
+  uint8_t pending_broadcast_;
+  color_t pending_broadcast_color_;
+};
+
+// G35ParallelPort drives up to eight strings whose data lines are all on the
+// same AVR port. Rather than finishing one string before starting the next,
+// it sends a command to every string at once, writing the whole port for each
+// bit. Eight strings take as long to update as one.
+//
+// Call show() regularly, for example after every ProgramRunner::loop(), to
+// send whatever the strings' programs have changed since the last call.
+//
+// Each string keeps a copy of its bulbs, about 200 bytes apiece, so more than
+// a few strings need a board with more RAM than an ATmega328.
+class G35ParallelPort {
+ public:
+  G35ParallelPort();
+
+  // Returns false if the string isn't on the same port as the ones already
+  // added, shares a pin with one of them, or there are already eight.
+  bool AddString(G35ParallelString* string);
+
+  // Gives each bulb on every string its address. See G35String::enumerate().
+  void enumerate();
+
+  // Sends everything the strings have changed since the last show().
+  void show();
+
+  // The protocol timings for every string on the port, since they share
+  // each bit. See G35String::set_timing().
+  void set_timing(const G35Timing& timing) { timing_ = timing; }
+
+ private:
+  enum { MAX_STRINGS = 8 };
+
+  // Sends one frame on every pin in |active| at once. |ones| holds, for
+  // each of the frame's bits in wire order, the pins sending a one.
+  void send(uint8_t active, const uint8_t* ones);
+
+  // Sends frames[i] to strings_[i], for every string whose bit is in
+  // |active|.
+  void send_frames(uint8_t active, const uint32_t* frames);
+
+  uint8_t string_count_;
+  G35ParallelString* strings_[MAX_STRINGS];
+  uint8_t bit_masks_[MAX_STRINGS];
+  uint8_t port_number_;
+  volatile uint8_t* port_;
+  G35Timing timing_;
+};
+
+#endif  // INCLUDE_G35_PARALLEL_PORT_H
@@ -0,0 +1,77 @@
+/*
+  G35: An Arduino library for GE Color Effects G-35 holiday lights.
+  Copyright © 2011 The G35 Authors. Use, modification, and distribution are
+  subject to the BSD license as described in the accompanying LICENSE file.
+
+  See README for complete attributions.
+*/
+
+#include <G35Player.h>
+
+G35Player::G35Player(G35& g35, const uint8_t* recording, size_t size)
+  : LightProgram(g35), recording_(recording), end_(recording + size),
+    has_overrun_(false) {
+  next_ = recording_;
+  is_valid_ = read() == 'G' && read() == '3' && read() == '5' &&
+    read() == G35_RECORDING_VERSION;
+  recorded_light_count_ = read_word();
+  // Bulb numbers have to stay clear of G35_RECORDING_BROADCAST.
+  is_valid_ = is_valid_ && !has_overrun_ && recorded_light_count_ != 0 &&
+    recorded_light_count_ < G35_RECORDING_BROADCAST;
+  rewind();
+}
+
+void G35Player::rewind() {
+  next_ = recording_ + G35_RECORDING_HEADER_SIZE;
+  has_overrun_ = false;
+  bulb_ = 0xffff;
+  intensity_ = G35::MAX_INTENSITY;
+  color_ = COLOR_BLACK;
+}
+
+uint32_t G35Player::Do() {
+  if (!is_valid_) {
+    return 1000;
+  }
+  bool has_rewound = false;
+  for (;;) {
+    uint8_t opcode = read();
+    if (opcode & G35_RECORDING_SET) {
+      uint8_t skip = opcode & G35_RECORDING_SKIP_MASK;
+      bulb_ = skip == G35_RECORDING_ABSOLUTE_BULB ?
+        read_word() : bulb_ + 1 + skip;
+      if (opcode & G35_RECORDING_HAS_INTENSITY) {
+        intensity_ = read();
+      }
+      if (opcode & G35_RECORDING_HAS_COLOR) {
+        color_ = read_word();
+      }
+      if (has_overrun_) {
+        // The recording stops partway through this command. Drop it, and the
+        // next read() ends the pass.
+        continue;
+      }
+      if (bulb_ == G35_RECORDING_BROADCAST) {
+        g35_.broadcast_intensity(intensity_);
+      } else if (bulb_ < light_count_) {
+        g35_.set_color(bulb_, intensity_, color_);
+      }
+    } else if (opcode == G35_RECORDING_LONG_WAIT) {
+      uint16_t ms = read_word();
+      if (!has_overrun_) {
+        return ms;
+      }
+    } else if (opcode != G35_RECORDING_END) {
+      return opcode;
+    } else if (!has_rewound) {
+      // The end, or where the recording was cut short. Start again, but
+      // leave the bulbs showing the last frame until the first wait of the
+      // next pass.
+      rewind();
+      has_rewound = true;
+    } else {
+      // The whole recording went by without a wait.
+      return 1000;
+    }
+  }
+}
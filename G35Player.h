@@ -0,0 +1,62 @@
+/*
+  G35: An Arduino library for GE Color Effects G-35 holiday lights.
+  Copyright © 2011 The G35 Authors. Use, modification, and distribution are
+  subject to the BSD license as described in the accompanying LICENSE file.
+
+  See README for complete attributions.
+*/
+
+#ifndef INCLUDE_G35_PLAYER_H
+#define INCLUDE_G35_PLAYER_H
+
+#include <G35Recording.h>
+#include <LightProgram.h>
+
+// Replays a show made by G35Recorder, over and over. Each command is a few
+// byte reads and a set_color(), however much work the original program did
+// to come up with it.
+//
+// On AVR, |recording| must be in PROGMEM, which is where a recording
+// converted to a C array belongs anyway; pass sizeof the array as |size|. On
+// the host it can be anywhere, including a MappedFile, whose size() it
+// takes. Nothing past |size| bytes is read: a recording cut short ends
+// there. Bulbs beyond the end of the string are skipped, so a recording made
+// for a longer string still plays.
+class G35Player : public LightProgram {
+ public:
+  G35Player(G35& g35, const uint8_t* recording, size_t size);
+  uint32_t Do();
+
+  // False if |recording| doesn't look like a recording.
+  bool is_valid() { return is_valid_; }
+
+  // The length of string the recording was made for.
+  uint16_t get_recorded_light_count() { return recorded_light_count_; }
+
+ private:
+  // Past the end, reads G35_RECORDING_END and notes the overrun.
+  uint8_t read() {
+    if (next_ == end_) {
+      has_overrun_ = true;
+      return G35_RECORDING_END;
+    }
+    return pgm_read_byte(next_++);
+  }
+  uint16_t read_word() {
+    uint8_t lo = read();
+    return lo | (uint16_t)read() << 8;
+  }
+  void rewind();
+
+  const uint8_t* recording_;
+  const uint8_t* end_;
+  const uint8_t* next_;
+  bool is_valid_;
+  bool has_overrun_;
+  uint16_t recorded_light_count_;
+  uint16_t bulb_;
+  uint8_t intensity_;
+  color_t color_;
+};
+
+#endif  // INCLUDE_G35_PLAYER_H
@@ -0,0 +1,78 @@
+/*
+  G35: An Arduino library for GE Color Effects G-35 holiday lights.
+  Copyright © 2011 The G35 Authors. Use, modification, and distribution are
+  subject to the BSD license as described in the accompanying LICENSE file.
+
+  Original version by Paul Martis (http://www.digitalmisery.com). See
+  README for complete attributions.
+*/
+
+#ifndef INCLUDE_G35_PROTOCOL_H
+#define INCLUDE_G35_PROTOCOL_H
+
+#include <G35.h>
+
+// Wire-level details of the one-wire protocol that G-35 bulbs speak, shared by
+// the classes that bit-bang it. Light programs shouldn't need any of this.
+//
+// A frame starts with a short high pulse, then sends 26 bits most
+// significant first, then stays low for a while. A zero bit is short low then
+// long high, and a one is the reverse. The 26 bits are a 6-bit bulb address,
+// an 8-bit intensity, then 4 bits each of blue, green and red.
+//
+// GE's controller uses about 10uS for short, 20uS for long and 30uS of quiet
+// after each frame.
+
+#ifndef F_CPU
+#define F_CPU 16000000UL
+#endif
+
+// Cycles each edge costs on top of its delayMicroseconds(): the port write,
+// testing and shifting the frame, and the call itself. The standard timings
+// leave that much out of each delay, so on a slow board the edges still land
+// where they should. At 16MHz and up it rounds to nothing.
+#define G35_EDGE_CYCLES (12)
+#define G35_EDGE_MICROS (G35_EDGE_CYCLES / (F_CPU / 1000000UL))
+
+// The standard timings, in microseconds. Define these before including the
+// library to change them everywhere, or see G35String::set_timing() to change
+// them for one string.
+#ifndef DELAYSHORT
+#define DELAYSHORT (10 - G35_EDGE_MICROS)
+#endif
+#ifndef DELAYLONG
+#define DELAYLONG (20 - G35_EDGE_MICROS)
+#endif
+#ifndef DELAYEND
+#define DELAYEND (40)
+#endif
+
+#define G35_FRAME_BITS (26)
+
+// How long one frame occupies the wire at the standard timings, start and
+// end included.
+#define G35_FRAME_MICROS \
+  (DELAYSHORT + G35_FRAME_BITS * (DELAYSHORT + DELAYLONG) + DELAYEND)
+
+// A set of protocol timings, in microseconds. The start pulse is short_us
+// long.
+struct G35Timing {
+  uint8_t short_us;
+  uint8_t long_us;
+  uint8_t end_us;
+
+  uint16_t get_frame_micros() const {
+    return short_us + G35_FRAME_BITS * (short_us + long_us) + end_us;
+  }
+};
+
+const G35Timing G35_STANDARD_TIMING = { DELAYSHORT, DELAYLONG, DELAYEND };
+
+// Conveniently, COMMAND() already packs intensity, blue, green and red in
+// wire order, so a whole frame is just the address on top.
+#define G35_FRAME_FROM_COMMAND(bulb, command)                   \
+  ((((uint32_t)(bulb) & 0x3f) << 20) | ((command) & 0xfffff))
+#define G35_FRAME(bulb, intensity, color)                       \
+  G35_FRAME_FROM_COMMAND(bulb, COMMAND(intensity, color))
+
+#endif  // INCLUDE_G35_PROTOCOL_H
@@ -0,0 +1,15 @@
+/*
+  G35: An Arduino library for GE Color Effects G-35 holiday lights.
+  Copyright © 2011 The G35 Authors. Use, modification, and distribution are
+  subject to the BSD license as described in the accompanying LICENSE file.
+
+  See README for complete attributions.
+*/
+
+#include <G35Random.h>
+
+G35Random G35Random::seeds_(DEFAULT_SEED);
+
+G35Random::G35Random() : state_(0) {
+  seed(seeds_.next());
+}
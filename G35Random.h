@@ -0,0 +1,70 @@
+/*
+  G35: An Arduino library for GE Color Effects G-35 holiday lights.
+  Copyright © 2011 The G35 Authors. Use, modification, and distribution are
+  subject to the BSD license as described in the accompanying LICENSE file.
+
+  See README for complete attributions.
+*/
+
+#ifndef INCLUDE_G35_RANDOM_H
+#define INCLUDE_G35_RANDOM_H
+
+#include <G35.h>
+
+// A small, fast random number generator for light programs.
+//
+// It's Marsaglia's 32-bit xorshift: three shifts and three exclusive ors per
+// number, with no multiplication, which suits an AVR far better than the C
+// library's rand(). Each LightProgram has its own as random_, so programs on
+// different strings don't disturb each other's sequences.
+//
+// New generators take their seeds from a library-wide sequence. Call
+// seed_all() once at startup, with analogRead() noise for a different show
+// every time or a constant for the same show every time.
+class G35Random {
+ public:
+  // Seeded from the library-wide sequence.
+  G35Random();
+  // Seeded with |seed|. Zero, which would stick at zero forever, is replaced
+  // with a fixed seed.
+  constexpr explicit G35Random(uint32_t seed)
+    : state_(seed != 0 ? seed : DEFAULT_SEED) {}
+
+  void seed(uint32_t seed) { state_ = seed != 0 ? seed : DEFAULT_SEED; }
+
+  // Any 32-bit value but zero.
+  uint32_t next() {
+    state_ ^= state_ << 13;
+    state_ ^= state_ >> 17;
+    state_ ^= state_ << 5;
+    return state_;
+  }
+
+  // A number from 0 to |bound| - 1. Scales rather than dividing, so it's
+  // cheap for any bound.
+  uint16_t uniform(uint16_t bound) {
+    return ((uint32_t)(next() >> 16) * bound) >> 16;
+  }
+
+  // A number from |low| to |high|, inclusive.
+  int16_t between(int16_t low, int16_t high) {
+    return low + (int16_t)uniform(high - low + 1);
+  }
+
+  bool coin() { return (next() & 0x80000000) != 0; }
+
+  // One of G35::max_color()'s colors.
+  color_t max_color() { return G35::max_color(uniform(7)); }
+
+  // Restarts the sequence that new generators are seeded from.
+  static void seed_all(uint32_t seed) { seeds_.seed(seed); }
+
+ private:
+  enum { DEFAULT_SEED = 2463534242UL };
+
+  uint32_t state_;
+
+  static G35Random seeds_;
+};
+
+#endif  // INCLUDE_G35_RANDOM_H
@@ -0,0 +1,124 @@
+/*
+  G35: An Arduino library for GE Color Effects G-35 holiday lights.
+  Copyright © 2011 The G35 Authors. Use, modification, and distribution are
+  subject to the BSD license as described in the accompanying LICENSE file.
+
+  See README for complete attributions.
+*/
+
+#include <G35Recorder.h>
+#include <G35Recording.h>
+
+G35Recorder::G35Recorder(uint16_t light_count, Print& out)
+  : G35(), out_(out), size_(0), last_bulb_(0xffff),
+    last_intensity_(MAX_INTENSITY), last_color_(COLOR_BLACK) {
+  light_count_ = light_count;
+  colors_ = static_cast<color_t*>(malloc(light_count * sizeof(color_t)));
+  intensities_ = static_cast<uint8_t*>(malloc(light_count));
+  memset(intensities_, UNKNOWN_INTENSITY, light_count);
+
+  write('G');
+  write('3');
+  write('5');
+  write(G35_RECORDING_VERSION);
+  write_word(light_count_);
+}
+
+G35Recorder::~G35Recorder() {
+  free(colors_);
+  free(intensities_);
+}
+
+void G35Recorder::set_color(uint16_t bulb, uint8_t intensity, color_t color) {
+  if (bulb >= light_count_) {
+    return;
+  }
+  if (intensity > MAX_INTENSITY) {
+    intensity = MAX_INTENSITY;
+  }
+  if (intensities_[bulb] == intensity && colors_[bulb] == color) {
+    return;
+  }
+  intensities_[bulb] = intensity;
+  colors_[bulb] = color;
+  write_set(bulb, intensity, color);
+}
+
+void G35Recorder::broadcast_intensity(uint8_t intensity) {
+  if (intensity > MAX_INTENSITY) {
+    intensity = MAX_INTENSITY;
+  }
+  for (uint16_t i = 0; i < light_count_; ++i) {
+    if (intensities_[i] != UNKNOWN_INTENSITY) {
+      intensities_[i] = intensity;
+    }
+  }
+  write_set(G35_RECORDING_BROADCAST, intensity, last_color_);
+}
+
+void G35Recorder::wait(uint32_t ms) {
+  while (ms >= G35_RECORDING_LONG_WAIT) {
+    uint16_t chunk = ms > 0xffff ? 0xffff : ms;
+    write(G35_RECORDING_LONG_WAIT);
+    write_word(chunk);
+    ms -= chunk;
+  }
+  if (ms > 0) {
+    write(ms);
+  }
+}
+
+void G35Recorder::record(LightProgram& program, uint32_t duration_ms) {
+  uint32_t elapsed = 0;
+  while (elapsed < duration_ms) {
+    uint32_t interval = program.Do();
+    // A program that asks to run again right away still has to let time
+    // pass in the recording, or this would never finish.
+    if (interval == 0) {
+      interval = 1;
+    }
+    wait(interval);
+    G35Clock::get_current()->delay(interval);
+    elapsed += interval;
+  }
+}
+
+void G35Recorder::end() {
+  write(G35_RECORDING_END);
+}
+
+void G35Recorder::write(uint8_t b) {
+  out_.write(b);
+  ++size_;
+}
+
+void G35Recorder::write_word(uint16_t w) {
+  write(w & 0xff);
+  write(w >> 8);
+}
+
+void G35Recorder::write_set(uint16_t bulb, uint8_t intensity, color_t color) {
+  uint8_t opcode = G35_RECORDING_SET;
+  uint16_t skip = bulb - last_bulb_ - 1;
+  bool is_absolute = skip >= G35_RECORDING_ABSOLUTE_BULB;
+  opcode |= is_absolute ? G35_RECORDING_ABSOLUTE_BULB : skip;
+  if (intensity != last_intensity_) {
+    opcode |= G35_RECORDING_HAS_INTENSITY;
+  }
+  if (color != last_color_) {
+    opcode |= G35_RECORDING_HAS_COLOR;
+  }
+  write(opcode);
+  if (is_absolute) {
+    write_word(bulb);
+  }
+  if (opcode & G35_RECORDING_HAS_INTENSITY) {
+    write(intensity);
+  }
+  if (opcode & G35_RECORDING_HAS_COLOR) {
+    write_word(color);
+  }
+  last_bulb_ = bulb;
+  last_intensity_ = intensity;
+  last_color_ = color;
+}
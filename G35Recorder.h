@@ -0,0 +1,76 @@
+/*
+  G35: An Arduino library for GE Color Effects G-35 holiday lights.
+  Copyright © 2011 The G35 Authors. Use, modification, and distribution are
+  subject to the BSD license as described in the accompanying LICENSE file.
+
+  See README for complete attributions.
+*/
+
+#ifndef INCLUDE_G35_RECORDER_H
+#define INCLUDE_G35_RECORDER_H
+
+#include <G35.h>
+#include <LightProgram.h>
+
+// A G35 with no lights attached. It writes every command it's given to a
+// Print, in the format described in G35Recording.h, so that G35Player can
+// replay the show later without the work of computing it.
+//
+// Create a program on a recorder just as on a real string, and let record()
+// run it:
+//
+//   G35Recorder recorder(50, output);
+//   Stereo stereo(recorder);
+//   recorder.record(stereo, 60000);
+//   recorder.end();
+//
+// The recorder writes the header as soon as it's constructed, so |out| must
+// be ready by then.
+//
+// Commands that wouldn't change a bulb aren't written.
+class G35Recorder : public G35 {
+ public:
+  G35Recorder(uint16_t light_count, Print& out);
+  ~G35Recorder();
+
+  virtual uint16_t get_light_count() { return light_count_; }
+  virtual void set_color(uint16_t bulb, uint8_t intensity, color_t color);
+  virtual void broadcast_intensity(uint8_t intensity);
+
+  // Notes that |ms| milliseconds pass before the next command.
+  void wait(uint32_t ms);
+
+  // Runs |program| for |duration_ms| milliseconds of show time, waiting out
+  // each frame with G35Clock's delay() so that programs watching the clock
+  // see time pass as they would live. Install a G35VirtualClock first to
+  // record faster than real time.
+  void record(LightProgram& program, uint32_t duration_ms);
+
+  // Marks the end of the recording.
+  void end();
+
+  // Bytes written so far.
+  uint32_t get_size() { return size_; }
+
+ protected:
+  // broadcast_intensity() is recorded as itself, so there's no bulb for it.
+  virtual uint8_t get_broadcast_bulb() { return 0; }
+
+ private:
+  enum { UNKNOWN_INTENSITY = 0xff };
+
+  void write(uint8_t b);
+  void write_word(uint16_t w);
+  void write_set(uint16_t bulb, uint8_t intensity, color_t color);
+
+  Print& out_;
+  uint32_t size_;
+  uint16_t last_bulb_;
+  uint8_t last_intensity_;
+  color_t last_color_;
+  // What each bulb was last told, to drop commands that change nothing.
+  color_t* colors_;
+  uint8_t* intensities_;
+};
+
+#endif  // INCLUDE_G35_RECORDER_H
@@ -0,0 +1,45 @@
+/*
+  G35: An Arduino library for GE Color Effects G-35 holiday lights.
+  Copyright © 2011 The G35 Authors. Use, modification, and distribution are
+  subject to the BSD license as described in the accompanying LICENSE file.
+
+  See README for complete attributions.
+*/
+
+#ifndef INCLUDE_G35_RECORDING_H
+#define INCLUDE_G35_RECORDING_H
+
+// The binary format G35Recorder writes and G35Player reads.
+//
+// A recording is a 6-byte header, "G35" then a version byte then the light
+// count (little-endian), followed by a stream of commands. Each command
+// starts with an opcode byte:
+//
+//   0x00              End of the recording.
+//   0x01-0x7e         Wait this many milliseconds.
+//   0x7f lo hi        Wait (hi << 8 | lo) milliseconds.
+//   1 I C sssss ...   Set a bulb. The bulb is the previous bulb plus one plus
+//                     s, or if s is 31, the two bytes that follow (lo, hi).
+//                     Then if I is set an intensity byte follows, and if C
+//                     is set a color follows (lo, hi). Otherwise the
+//                     previous command's intensity or color is reused.
+//
+// The "previous" values start at bulb -1, MAX_INTENSITY and COLOR_BLACK, so a
+// frame that paints a string from one end to the other in one color costs a
+// byte per bulb. Bulb G35_RECORDING_BROADCAST stands for
+// broadcast_intensity().
+
+#define G35_RECORDING_VERSION 1
+#define G35_RECORDING_HEADER_SIZE 6
+
+#define G35_RECORDING_END 0x00
+#define G35_RECORDING_LONG_WAIT 0x7f
+#define G35_RECORDING_SET 0x80
+#define G35_RECORDING_HAS_INTENSITY 0x40
+#define G35_RECORDING_HAS_COLOR 0x20
+#define G35_RECORDING_SKIP_MASK 0x1f
+#define G35_RECORDING_ABSOLUTE_BULB 0x1f
+
+#define G35_RECORDING_BROADCAST 0xffff
+
+#endif  // INCLUDE_G35_RECORDING_H
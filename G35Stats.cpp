@@ -0,0 +1,76 @@
+/*
+  G35: An Arduino library for GE Color Effects G-35 holiday lights.
+  Copyright © 2011 The G35 Authors. Use, modification, and distribution are
+  subject to the BSD license as described in the accompanying LICENSE file.
+
+  See README for complete attributions.
+*/
+
+#include <G35Stats.h>
+
+#if G35_STATS
+
+G35WireStats G35Stats::wire;
+
+// static
+void G35Stats::print(Print& out, const G35ProgramStats* stats,
+                     uint8_t count) {
+  out.println(F("# program frames missed avg_us max_us bulbs skipped dropped "
+                "bits irq_off_us histogram_ms<1,2,4,8,16,32,64,inf>"));
+  for (uint8_t i = 0; i < count; ++i) {
+    const G35ProgramStats& s = stats[i];
+    out.print(i);
+    out.print(' ');
+    out.print(s.frames);
+    out.print(' ');
+    out.print(s.missed_deadlines);
+    out.print(' ');
+    out.print(s.frames ? s.do_micros / s.frames : 0);
+    out.print(' ');
+    out.print(s.max_do_micros);
+    out.print(' ');
+    out.print(s.wire.bulbs_written);
+    out.print(' ');
+    out.print(s.wire.bulbs_skipped);
+    out.print(' ');
+    out.print(s.wire.bulbs_dropped);
+    out.print(' ');
+    out.print(s.wire.bits_sent);
+    out.print(' ');
+    out.print(s.wire.interrupts_off_micros);
+    for (uint8_t b = 0; b < G35ProgramStats::HISTOGRAM_BUCKETS; ++b) {
+      out.print(b == 0 ? ' ' : ',');
+      out.print(s.do_histogram[b]);
+    }
+    out.println();
+  }
+}
+
+void G35FrameRecorder::finish(G35ProgramStats* stats) {
+  uint32_t elapsed = micros() - start_micros_;
+  ++stats->frames;
+  stats->do_micros += elapsed;
+  if (elapsed > stats->max_do_micros) {
+    stats->max_do_micros = elapsed;
+  }
+
+  uint8_t bucket = 0;
+  for (uint32_t millis = elapsed / 1000;
+       millis > 0 && bucket < G35ProgramStats::HISTOGRAM_BUCKETS - 1;
+       millis >>= 1) {
+    ++bucket;
+  }
+  if (stats->do_histogram[bucket] != 0xffff) {
+    ++stats->do_histogram[bucket];
+  }
+
+  const G35WireStats& now = G35Stats::wire;
+  stats->wire.bulbs_written += now.bulbs_written - wire_.bulbs_written;
+  stats->wire.bulbs_skipped += now.bulbs_skipped - wire_.bulbs_skipped;
+  stats->wire.bulbs_dropped += now.bulbs_dropped - wire_.bulbs_dropped;
+  stats->wire.bits_sent += now.bits_sent - wire_.bits_sent;
+  stats->wire.interrupts_off_micros +=
+    now.interrupts_off_micros - wire_.interrupts_off_micros;
+}
+
+#endif  // G35_STATS
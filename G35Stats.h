@@ -0,0 +1,102 @@
+/*
+  G35: An Arduino library for GE Color Effects G-35 holiday lights.
+  Copyright © 2011 The G35 Authors. Use, modification, and distribution are
+  subject to the BSD license as described in the accompanying LICENSE file.
+
+  See README for complete attributions.
+*/
+
+#ifndef INCLUDE_G35_STATS_H
+#define INCLUDE_G35_STATS_H
+
+#include <Arduino.h>
+#include <G35Protocol.h>
+
+// Frame timing instrumentation. Set G35_STATS to 1 (here, or with -D in a
+// build that allows it) to count how long light programs take, how much
+// they send and how long interrupts are off while they do it. At 0, the
+// default, none of this is compiled and it costs nothing.
+#ifndef G35_STATS
+#define G35_STATS (0)
+#endif
+
+#if G35_STATS
+
+// Everything sent to the lights, by every string, since startup.
+struct G35WireStats {
+  uint32_t bulbs_written;         // Frames that went out on a wire, or into
+                                  // the asynchronous queue.
+  uint32_t bulbs_skipped;         // set_color() calls that changed nothing.
+  uint32_t bulbs_dropped;         // Frames the full queue turned away.
+  uint32_t bits_sent;
+  uint32_t interrupts_off_micros;
+};
+
+// Counters for one light program, accumulated over every time it has run.
+struct G35ProgramStats {
+  enum {
+    // Do() durations are bucketed by powers of two in milliseconds: bucket
+    // 0 is under 1mS, bucket 1 under 2mS, and so on. The last bucket takes
+    // everything longer.
+    HISTOGRAM_BUCKETS = 8
+  };
+
+  uint32_t frames;
+  uint32_t missed_deadlines;
+  uint32_t do_micros;
+  uint32_t max_do_micros;
+  uint16_t do_histogram[HISTOGRAM_BUCKETS];
+  G35WireStats wire;
+};
+
+class G35Stats {
+ public:
+  static G35WireStats wire;
+
+  // Called by the classes that talk to bulbs.
+  static void count_frame(uint8_t bulbs, uint32_t interrupts_off_micros) {
+    wire.bulbs_written += bulbs;
+    wire.bits_sent += (uint32_t)bulbs * G35_FRAME_BITS;
+    wire.interrupts_off_micros += interrupts_off_micros;
+  }
+  static void count_skipped_bulb() { ++wire.bulbs_skipped; }
+  static void count_dropped_bulb() { ++wire.bulbs_dropped; }
+
+  // Writes |count| programs' stats to |out|, one line per program, after a
+  // header line starting with '#'. Columns are separated by spaces.
+  static void print(Print& out, const G35ProgramStats* stats, uint8_t count);
+};
+
+// Attributes the time and wire traffic between its construction and
+// finish() to a program.
+class G35FrameRecorder {
+ public:
+  G35FrameRecorder() : wire_(G35Stats::wire), start_micros_(micros()) {}
+
+  void finish(G35ProgramStats* stats);
+
+ private:
+  G35WireStats wire_;
+  uint32_t start_micros_;
+};
+
+#define G35_STATS_INTERRUPTS_OFF() uint32_t g35_stats_micros = micros()
+#define G35_STATS_INTERRUPTS_ON(bulbs) \
+  G35Stats::count_frame(bulbs, micros() - g35_stats_micros)
+#define G35_STATS_SKIPPED_BULB() G35Stats::count_skipped_bulb()
+// A frame queued for G35AsyncTransmitter, which turns interrupts off only
+// in its own handler, or one the queue had no room for.
+#define G35_STATS_QUEUED_BULB() G35Stats::count_frame(1, 0)
+#define G35_STATS_DROPPED_BULB() G35Stats::count_dropped_bulb()
+
+#else  // G35_STATS
+
+#define G35_STATS_INTERRUPTS_OFF()
+#define G35_STATS_INTERRUPTS_ON(bulbs)
+#define G35_STATS_SKIPPED_BULB()
+#define G35_STATS_QUEUED_BULB()
+#define G35_STATS_DROPPED_BULB()
+
+#endif  // G35_STATS
+
+#endif  // INCLUDE_G35_STATS_H
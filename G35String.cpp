@@ -12,100 +12,241 @@
 */
 
 #include <G35String.h>
+#include <G35AsyncTransmitter.h>
+#include <G35Protocol.h>
+#include <G35Stats.h>
 
-#define MHZ_16 (1)  // standard Arduino/Teensy
+// Edges are single writes to the pin's output register, which cost a handful
+// of cycles; G35_EDGE_CYCLES accounts for them in the standard timings. The
+// delays come from the |short_us| and |long_us| locals of send().
+#define ZERO(port, mask) *port &= ~mask;        \
+  delayMicroseconds(short_us);                  \
+  *port |= mask;                                \
+  delayMicroseconds(long_us);
 
-#if MHZ_16
-#define DELAYLONG 17    // should be ~ 20uS long
-#define DELAYSHORT 7   // should be ~ 10uS long
-#else  // 20MHz
-#define DELAYLONG 25    // should be ~ 20uS long
-#define DELAYSHORT 11   // should be ~ 10uS long
-#endif
-#define DELAYEND 40     // should be ~ 30uS long
+#define ONE(port, mask) *port &= ~mask;         \
+  delayMicroseconds(long_us);                   \
+  *port |= mask;                                \
+  delayMicroseconds(short_us);
 
-#define ZERO(x) digitalWrite(x, LOW);           \
-  delayMicroseconds(DELAYSHORT);                \
-  digitalWrite(x, HIGH);                        \
-  delayMicroseconds(DELAYLONG);
-
-#define ONE(x) digitalWrite(x, LOW);            \
-  delayMicroseconds(DELAYLONG);                 \
-  digitalWrite(x, HIGH);                        \
-  delayMicroseconds(DELAYSHORT);
+// Sends the top bit of |frame| and moves the next one up.
+#define BIT(port, mask, frame)                  \
+  if (frame & 0x80000000) {                     \
+    ONE(port, mask);                            \
+  } else {                                      \
+    ZERO(port, mask);                           \
+  }                                             \
+  frame <<= 1;
 
 G35String::G35String(uint8_t pin, uint8_t light_count,
                      uint8_t physical_light_count,
                      uint8_t bulb_zero, bool is_forward)
 : G35(), pin_(pin), physical_light_count_(physical_light_count),
-  bulb_zero_(bulb_zero), is_forward_(is_forward) {
+  bulb_zero_(bulb_zero), is_forward_(is_forward), is_async_(false),
+  timing_(G35_STANDARD_TIMING) {
   pinMode(pin, OUTPUT);
+  port_ = portOutputRegister(digitalPinToPort(pin));
+  bit_mask_ = digitalPinToBitMask(pin);
   light_count_ = light_count;
+  invalidate();
 }
 
 G35String::G35String(uint8_t pin, uint8_t light_count)
 : G35(), pin_(pin), physical_light_count_(light_count),
-  bulb_zero_(0), is_forward_(true) {
+  bulb_zero_(0), is_forward_(true), is_async_(false),
+  timing_(G35_STANDARD_TIMING) {
   pinMode(pin, OUTPUT);
+  port_ = portOutputRegister(digitalPinToPort(pin));
+  bit_mask_ = digitalPinToBitMask(pin);
   light_count_ = light_count;
+  invalidate();
+}
+
+void G35String::set_color(uint16_t bulb, uint8_t intensity, color_t color) {
+  set_command(bulb, COMMAND(intensity, color));
 }
 
-void G35String::set_color(uint8_t bulb, uint8_t intensity, color_t color) {
-  bulb += bulb_zero_;
-  uint8_t r, g, b;
-  r = color & 0x0F;
-  g = (color >> 4) & 0x0F;
-  b = (color >> 8) & 0x0F;
+void G35String::set_command(uint16_t bulb, command_t command) {
+  // The wire only carries six address bits, so the shadow uses the same view.
+  uint8_t address = bulb == BROADCAST_BULB ?
+    BROADCAST_BULB : (bulb + bulb_zero_) & BROADCAST_BULB;
+  uint8_t intensity = COMMAND_INTENSITY(command);
+  color_t color = COMMAND_COLOR(command);
 
   if (intensity > MAX_INTENSITY) {
     intensity = MAX_INTENSITY;
+    command = COMMAND(intensity, color);
+  }
+
+  if (address == BROADCAST_BULB) {
+    // Broadcasts always go out. Every bulb takes on the new intensity, and
+    // the new color too unless it's black. Bulbs ignore a black broadcast's
+    // color, which is what lets broadcast_intensity() fade a string without
+    // changing what it shows.
+    for (uint8_t i = 0; i < MAX_BULBS; ++i) {
+      if (color != COLOR_BLACK) {
+        shadow_color_[i] = color;
+        shadow_intensity_[i] = intensity;
+      } else if (shadow_intensity_[i] != UNKNOWN_INTENSITY) {
+        shadow_intensity_[i] = intensity;
+      }
+    }
+  } else {
+    if (shadow_intensity_[address] == intensity &&
+        shadow_color_[address] == color) {
+      G35_STATS_SKIPPED_BULB();
+      return;
+    }
+    shadow_intensity_[address] = intensity;
+    shadow_color_[address] = color;
+  }
+  if (!send(G35_FRAME_FROM_COMMAND(address, command))) {
+    // The bulb (or for a broadcast, every bulb) might not be showing what
+    // the shadow says, so make sure the next write to it goes out.
+    if (address == BROADCAST_BULB) {
+      invalidate();
+    } else {
+      shadow_intensity_[address] = UNKNOWN_INTENSITY;
+    }
+  }
+}
+
+void G35String::set_colors(uint16_t begin, uint16_t count,
+                           const color_t* colors, const uint8_t* intensities) {
+  if (begin == 0 && count >= light_count_ &&
+      is_solid(count, colors, intensities) &&
+      fill_all(intensities[0], colors[0])) {
+    return;
   }
+  while (count--) {
+    set_command(begin++, COMMAND(*intensities++, *colors++));
+  }
+}
+
+void G35String::set_commands(uint16_t begin, uint16_t count,
+                             const command_t* commands) {
+  while (count--) {
+    set_command(begin++, *commands++);
+  }
+}
+
+bool G35String::fill_all(uint8_t intensity, color_t color) {
+  // A broadcast reaches every bulb on the wire, so it's only a fill if every
+  // bulb on the wire is visible.
+  if (bulb_zero_ != 0 || physical_light_count_ != light_count_) {
+    return false;
+  }
+  if (color == COLOR_BLACK) {
+    // A black broadcast can't paint bulbs black, since they keep their
+    // colors, but one at intensity 0 darkens them all the same. Bulbs whose
+    // color isn't known stay unknown in the shadow.
+    for (uint8_t i = 0; i < physical_light_count_; ++i) {
+      if (shadow_intensity_[i] == UNKNOWN_INTENSITY ||
+          (shadow_intensity_[i] != 0 && shadow_color_[i] != COLOR_BLACK)) {
+        set_command(BROADCAST_BULB, COMMAND(0, COLOR_BLACK));
+        return true;
+      }
+    }
+    return true;
+  }
+  if (intensity > MAX_INTENSITY) {
+    intensity = MAX_INTENSITY;
+  }
+  for (uint8_t i = 0; i < physical_light_count_; ++i) {
+    if (shadow_intensity_[i] != intensity || shadow_color_[i] != color) {
+      set_command(BROADCAST_BULB, COMMAND(intensity, color));
+      return true;
+    }
+  }
+  // Already showing it.
+  return true;
+}
+
+void G35String::invalidate() {
+  for (uint8_t i = 0; i < MAX_BULBS; ++i) {
+    shadow_intensity_[i] = UNKNOWN_INTENSITY;
+    shadow_color_[i] = COLOR_BLACK;
+  }
+}
+
+void G35String::resync() {
+  for (uint8_t i = 0; i < MAX_BULBS; ++i) {
+    if (shadow_intensity_[i] != UNKNOWN_INTENSITY &&
+        !send(G35_FRAME(i, shadow_intensity_[i], shadow_color_[i]))) {
+      shadow_intensity_[i] = UNKNOWN_INTENSITY;
+    }
+  }
+}
+
+void G35String::set_async(bool is_async) {
+  if (is_async_ && !is_async) {
+    G35AsyncTransmitter::flush();
+  }
+  is_async_ = is_async;
+}
+
+void G35String::set_timing(const G35Timing& timing) {
+  // Frames already queued would go out with the new timing.
+  if (is_async_) {
+    G35AsyncTransmitter::flush();
+  }
+  timing_ = timing;
+}
+
+bool G35String::send(uint32_t frame) {
+  if (is_async_) {
+    if (!G35AsyncTransmitter::enqueue(port_, bit_mask_, frame, &timing_)) {
+      G35_STATS_DROPPED_BULB();
+      return false;
+    }
+    G35_STATS_QUEUED_BULB();
+    return true;
+  }
+
+  // Keep these in registers. delayMicroseconds() is an out-of-line call, so
+  // the compiler would otherwise reload them from |this| after every edge.
+  volatile uint8_t* port = port_;
+  const uint8_t mask = bit_mask_;
+  const uint8_t short_us = timing_.short_us;
+  const uint8_t long_us = timing_.long_us;
+
+  // Line the first bit up with the top of the word, so that BIT() only ever
+  // tests the top bit and shifts by one.
+  frame <<= 32 - G35_FRAME_BITS;
 
+  G35_STATS_INTERRUPTS_OFF();
   noInterrupts();
 
-  digitalWrite(pin_, HIGH);
-  delayMicroseconds(DELAYSHORT);
+  *port |= mask;
+  delayMicroseconds(short_us);
 
   // LED Address
-  if (bulb & 0x20) { ONE(pin_); } else { ZERO(pin_); }
-  if (bulb & 0x10) { ONE(pin_); } else { ZERO(pin_); }
-  if (bulb & 0x08) { ONE(pin_); } else { ZERO(pin_); }
-  if (bulb & 0x04) { ONE(pin_); } else { ZERO(pin_); }
-  if (bulb & 0x02) { ONE(pin_); } else { ZERO(pin_); }
-  if (bulb & 0x01) { ONE(pin_); } else { ZERO(pin_); }
+  BIT(port, mask, frame); BIT(port, mask, frame); BIT(port, mask, frame);
+  BIT(port, mask, frame); BIT(port, mask, frame); BIT(port, mask, frame);
 
   // Brightness
-  if (intensity & 0x80) { ONE(pin_); } else { ZERO(pin_); }
-  if (intensity & 0x40) { ONE(pin_); } else { ZERO(pin_); }
-  if (intensity & 0x20) { ONE(pin_); } else { ZERO(pin_); }
-  if (intensity & 0x10) { ONE(pin_); } else { ZERO(pin_); }
-  if (intensity & 0x08) { ONE(pin_); } else { ZERO(pin_); }
-  if (intensity & 0x04) { ONE(pin_); } else { ZERO(pin_); }
-  if (intensity & 0x02) { ONE(pin_); } else { ZERO(pin_); }
-  if (intensity & 0x01) { ONE(pin_); } else { ZERO(pin_); }
+  BIT(port, mask, frame); BIT(port, mask, frame); BIT(port, mask, frame);
+  BIT(port, mask, frame); BIT(port, mask, frame); BIT(port, mask, frame);
+  BIT(port, mask, frame); BIT(port, mask, frame);
 
   // Blue
-  if (b & 0x8) { ONE(pin_); } else { ZERO(pin_); }
-  if (b & 0x4) { ONE(pin_); } else { ZERO(pin_); }
-  if (b & 0x2) { ONE(pin_); } else { ZERO(pin_); }
-  if (b & 0x1) { ONE(pin_); } else { ZERO(pin_); }
+  BIT(port, mask, frame); BIT(port, mask, frame);
+  BIT(port, mask, frame); BIT(port, mask, frame);
 
   // Green
-  if (g & 0x8) { ONE(pin_); } else { ZERO(pin_); }
-  if (g & 0x4) { ONE(pin_); } else { ZERO(pin_); }
-  if (g & 0x2) { ONE(pin_); } else { ZERO(pin_); }
-  if (g & 0x1) { ONE(pin_); } else { ZERO(pin_); }
+  BIT(port, mask, frame); BIT(port, mask, frame);
+  BIT(port, mask, frame); BIT(port, mask, frame);
 
   // Red
-  if (r & 0x8) { ONE(pin_); } else { ZERO(pin_); }
-  if (r & 0x4) { ONE(pin_); } else { ZERO(pin_); }
-  if (r & 0x2) { ONE(pin_); } else { ZERO(pin_); }
-  if (r & 0x1) { ONE(pin_); } else { ZERO(pin_); }
+  BIT(port, mask, frame); BIT(port, mask, frame);
+  BIT(port, mask, frame); BIT(port, mask, frame);
 
-  digitalWrite(pin_, LOW);
-  delayMicroseconds(DELAYEND);
+  *port &= ~mask;
+  delayMicroseconds(timing_.end_us);
 
   interrupts();
+  G35_STATS_INTERRUPTS_ON(1);
+  return true;
 }
 
 void G35String::enumerate() {
@@ -113,6 +254,9 @@ void G35String::enumerate() {
 }
 
 void G35String::enumerate(bool forward) {
+  // Until they're enumerated, the bulbs don't have the addresses the shadow
+  // thinks they have, so every command must go out.
+  invalidate();
   uint8_t count = physical_light_count_;
   uint8_t bulb = forward ? 0 : light_count_ - 1;
   int8_t delta = forward ? 1 : -1;
@@ -11,6 +11,7 @@
 #define INCLUDE_G35_STRING_H
 
 #include <G35.h>
+#include <G35Protocol.h>
 
 // A G35String knows how to talk to a real GE Color Effects light string.
 // In particular, it implements the set_color() method of the G35 interface.
@@ -22,6 +23,11 @@
 // to all bulbs starting with bulb #0 and ending with bulb #N-1. If your
 // light programs look right but fractured, it's because you forgot to call
 // enumerate().
+//
+// G35String remembers the last color and intensity it sent to each bulb, and
+// set_color() skips the wire entirely when a bulb is already showing what it's
+// asked to show. If something other than this object changes the bulbs (a
+// power glitch, another controller), call resync() or invalidate().
 class G35String : public G35 {
  public:
   // |pin|: the Arduino pin driving this string's data line.
@@ -35,11 +41,35 @@ class G35String : public G35 {
 
   // Implementation of G35 interface.
   virtual uint16_t get_light_count() { return light_count_; }
-  void set_color(uint8_t led, uint8_t intensity, color_t color);
+  void set_color(uint16_t led, uint8_t intensity, color_t color);
+  void set_colors(uint16_t begin, uint16_t count,
+                  const color_t* colors, const uint8_t* intensities);
+  void set_commands(uint16_t begin, uint16_t count, const command_t* commands);
+  bool fill_all(uint8_t intensity, color_t color);
 
   // Initialize lights by giving them each an address.
   void enumerate();
 
+  // Forgets what each bulb is showing, so that the next set_color() to every
+  // bulb is sent even if it looks redundant.
+  void invalidate();
+
+  // Resends the last known state of every bulb.
+  void resync();
+
+  // In asynchronous mode, commands go to G35AsyncTransmitter's queue and are
+  // sent from a timer interrupt while the sketch carries on. A sketch that
+  // uses it must also say G35_ASYNC_ISR() once; see G35AsyncTransmitter.h.
+  // Turning it off waits for the queue to drain.
+  void set_async(bool is_async);
+
+  // The protocol timings this string sends with. They start out as
+  // G35_STANDARD_TIMING. Faster timings make every frame shorter, so the
+  // string can refresh more often, but not every string tolerates them; see
+  // G35TimingCalibrator to find out what yours does.
+  void set_timing(const G35Timing& timing);
+  const G35Timing& get_timing() { return timing_; }
+
   // Displays known-good patterns. Useful to prevent insanity during hardware
   // debugging.
   void do_test_patterns();
@@ -49,15 +79,31 @@ class G35String : public G35 {
 
  private:
   uint8_t pin_;
+  // The output register and bit for |pin_|, looked up once so that sending
+  // a bit doesn't go through digitalWrite().
+  volatile uint8_t* port_;
+  uint8_t bit_mask_;
   uint8_t physical_light_count_;
   uint8_t bulb_zero_;
   bool is_forward_;
+  bool is_async_;
+  G35Timing timing_;
 
   enum {
     MAX_INTENSITY = 0xcc,
     BROADCAST_BULB = 63,
+    // Bulb addresses are six bits wide, and the last one is the broadcast
+    // address.
+    MAX_BULBS = BROADCAST_BULB,
+    // No real command has this intensity, so a bulb whose shadow holds it is
+    // in an unknown state.
+    UNKNOWN_INTENSITY = 0xff,
   };
 
+  // The last command sent to each bulb, indexed by wire address.
+  color_t shadow_color_[MAX_BULBS];
+  uint8_t shadow_intensity_[MAX_BULBS];
+
   // Initialize lights by giving them each an address. enumerate_forward()
   // numbers the bulb closest to the controller 0, and enumerate_reverse()
   // numbers the farthest bulb 0.
@@ -65,6 +111,13 @@ class G35String : public G35 {
   void enumerate_forward();
   void enumerate_reverse();
 
+  // set_color() with the intensity and color already packed.
+  void set_command(uint16_t bulb, command_t command);
+
+  // Puts a single frame (see G35_FRAME()) on the wire, regardless of shadow
+  // state. Returns false if the asynchronous queue dropped it.
+  bool send(uint32_t frame);
+
   // Low-level one-wire protocol commands
   void begin();
   void one();
@@ -10,7 +10,7 @@
 #include <G35StringGroup.h>
 
 G35StringGroup::G35StringGroup()
-: string_count_(0) {
+: string_count_(0), last_string_(0) {
   light_count_ = 0;
 }
 
@@ -32,16 +32,37 @@ uint16_t G35StringGroup::get_light_count() {
   return light_count_;
 }
 
-void G35StringGroup::set_color(uint8_t bulb, uint8_t intensity, color_t color) {
-  uint8_t string = 0;
-  while (bulb >= string_offsets_[string] && string < string_count_) {
-    string++;
+uint8_t G35StringGroup::find_string(uint16_t bulb) {
+  if (bulb >= light_count_) {
+    return string_count_;
   }
-  if (string < string_count_) {
-    if (string > 0) {
-      bulb -= string_offsets_[string - 1];
+
+  // Programs mostly walk along the string, so the string that held the last
+  // bulb very likely holds this one, too.
+  uint8_t string = last_string_;
+  if (bulb < string_offsets_[string] && bulb >= string_start(string)) {
+    return string;
+  }
+
+  uint8_t low = 0;
+  uint8_t high = string_count_ - 1;
+  while (low < high) {
+    uint8_t middle = (low + high) >> 1;
+    if (bulb < string_offsets_[middle]) {
+      high = middle;
+    } else {
+      low = middle + 1;
     }
-    strings_[string]->set_color(bulb, intensity, color);
+  }
+  last_string_ = low;
+  return low;
+}
+
+void G35StringGroup::set_color(uint16_t bulb, uint8_t intensity,
+                               color_t color) {
+  uint8_t string = find_string(bulb);
+  if (string < string_count_) {
+    strings_[string]->set_color(bulb - string_start(string), intensity, color);
   } else {
     // A program is misbehaving.
 #if 0
@@ -50,6 +71,54 @@ void G35StringGroup::set_color(uint8_t bulb, uint8_t intensity, color_t color) {
   }
 }
 
+void G35StringGroup::set_colors(uint16_t begin, uint16_t count,
+                                const color_t* colors,
+                                const uint8_t* intensities) {
+  uint8_t string = find_string(begin);
+  while (count > 0 && string < string_count_) {
+    uint16_t start = string_start(string);
+    uint16_t span = string_offsets_[string] - begin;
+    if (span > count) {
+      span = count;
+    }
+    strings_[string]->set_colors(begin - start, span, colors, intensities);
+    begin += span;
+    count -= span;
+    colors += span;
+    intensities += span;
+    ++string;
+  }
+}
+
+void G35StringGroup::set_commands(uint16_t begin, uint16_t count,
+                                  const command_t* commands) {
+  uint8_t string = find_string(begin);
+  while (count > 0 && string < string_count_) {
+    uint16_t start = string_start(string);
+    uint16_t span = string_offsets_[string] - begin;
+    if (span > count) {
+      span = count;
+    }
+    strings_[string]->set_commands(begin - start, span, commands);
+    begin += span;
+    count -= span;
+    commands += span;
+    ++string;
+  }
+}
+
+bool G35StringGroup::fill_all(uint8_t intensity, color_t color) {
+  // Strings that can't take the shortcut get filled the usual way, so the
+  // group as a whole can always say yes.
+  for (uint8_t i = 0; i < string_count_; ++i) {
+    G35* string = strings_[i];
+    if (!string->fill_all(intensity, color)) {
+      string->fill_color(0, string->get_light_count(), intensity, color);
+    }
+  }
+  return true;
+}
+
 void G35StringGroup::broadcast_intensity(uint8_t intensity) {
   for (uint8_t i = 0; i < string_count_; ++i) {
     strings_[i]->broadcast_intensity(intensity);
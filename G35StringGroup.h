@@ -26,7 +26,12 @@ class G35StringGroup : public G35 {
 
   virtual uint16_t get_light_count();
 
-  virtual void set_color(uint8_t bulb, uint8_t intensity, color_t color);
+  virtual void set_color(uint16_t bulb, uint8_t intensity, color_t color);
+  virtual void set_colors(uint16_t begin, uint16_t count,
+                          const color_t* colors, const uint8_t* intensities);
+  virtual void set_commands(uint16_t begin, uint16_t count,
+                            const command_t* commands);
+  virtual bool fill_all(uint8_t intensity, color_t color);
   virtual void broadcast_intensity(uint8_t intensity);
 
  protected:
@@ -35,9 +40,20 @@ class G35StringGroup : public G35 {
  private:
   enum { MAX_STRINGS = 16 };
 
+  // Returns the index of the string containing |bulb|, or string_count_ if
+  // there isn't one.
+  uint8_t find_string(uint16_t bulb);
+
+  // The first bulb of string |string|.
+  uint16_t string_start(uint8_t string) {
+    return string == 0 ? 0 : string_offsets_[string - 1];
+  }
+
   uint8_t string_count_;
   G35* strings_[MAX_STRINGS];
+  // One past the last bulb of each string.
   uint16_t string_offsets_[MAX_STRINGS];
+  uint8_t last_string_;
 };
 
 #endif  // INCLUDE_G35_STRING_GROUP_H
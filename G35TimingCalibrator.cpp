@@ -0,0 +1,68 @@
+/*
+  G35: An Arduino library for GE Color Effects G-35 holiday lights.
+  Copyright © 2011 The G35 Authors. Use, modification, and distribution are
+  subject to the BSD license as described in the accompanying LICENSE file.
+
+  See README for complete attributions.
+*/
+
+#include <G35TimingCalibrator.h>
+
+// static
+G35Timing G35TimingCalibrator::calibrate(G35String& lights,
+                                         bool (*is_lit)()) {
+  const G35Timing standard = G35_STANDARD_TIMING;
+
+  // If the standard timings don't pass, the sensor can't be trusted.
+  G35Timing previous = standard;
+  G35Timing chosen = standard;
+  if (try_timing(lights, standard, is_lit)) {
+    // Every timing shrinks in proportion to the short one.
+    for (uint8_t short_us = standard.short_us - 1;
+         short_us >= MIN_SHORT_MICROS; --short_us) {
+      G35Timing candidate;
+      candidate.short_us = short_us;
+      candidate.long_us = (uint16_t)standard.long_us * short_us /
+        standard.short_us;
+      candidate.end_us = (uint16_t)standard.end_us * short_us /
+        standard.short_us;
+      if (!try_timing(lights, candidate, is_lit)) {
+        break;
+      }
+      chosen = previous;
+      previous = candidate;
+    }
+  }
+
+  lights.set_timing(standard);
+  fill(lights, COLOR_BLACK);
+  lights.set_timing(chosen);
+  return chosen;
+}
+
+// static
+bool G35TimingCalibrator::try_timing(G35String& lights,
+                                     const G35Timing& timing,
+                                     bool (*is_lit)()) {
+  // Start from a known dark string.
+  lights.set_timing(G35_STANDARD_TIMING);
+  fill(lights, COLOR_BLACK);
+
+  lights.set_timing(timing);
+  fill(lights, COLOR_WHITE);
+  if (!is_lit()) {
+    return false;
+  }
+  fill(lights, COLOR_BLACK);
+  return !is_lit();
+}
+
+// static
+void G35TimingCalibrator::fill(G35String& lights, color_t color) {
+  // Resend even if the string thinks the bulbs already show |color|, since
+  // at a bad timing they might not.
+  lights.invalidate();
+  for (uint16_t i = 0; i < lights.get_light_count(); ++i) {
+    lights.set_color(i, G35::MAX_INTENSITY, color);
+  }
+}
@@ -0,0 +1,52 @@
+/*
+  G35: An Arduino library for GE Color Effects G-35 holiday lights.
+  Copyright © 2011 The G35 Authors. Use, modification, and distribution are
+  subject to the BSD license as described in the accompanying LICENSE file.
+
+  See README for complete attributions.
+*/
+
+#ifndef INCLUDE_G35_TIMING_CALIBRATOR_H
+#define INCLUDE_G35_TIMING_CALIBRATOR_H
+
+#include <G35String.h>
+
+// Finds the fastest protocol timings a particular string reliably obeys.
+//
+// Bulbs can't answer back, so calibration needs something that can see them:
+// a photoresistor on an analog pin, say, or a person with a button. The
+// calibrator lights the string and darkens it again at faster and faster
+// timings, and after each step asks |is_lit| whether the string is lit. It
+// stops at the first timing that gives the wrong answer and settles on one
+// step slower than the fastest that worked, for margin.
+//
+//   bool is_lit() {
+//     delay(100);  // Let the sensor settle.
+//     return analogRead(A0) > 500;
+//   }
+//
+//   G35Timing fast = G35TimingCalibrator::calibrate(lights, is_lit);
+//
+// The result is already set on the string, and can be stored (in EEPROM, for
+// example) and given to set_timing() at the next startup instead of
+// calibrating again. The string is left dark.
+class G35TimingCalibrator {
+ public:
+  static G35Timing calibrate(G35String& lights, bool (*is_lit)());
+
+ private:
+  enum {
+    // delayMicroseconds() can't do much better than this.
+    MIN_SHORT_MICROS = 3,
+  };
+
+  // Lights every bulb individually at |timing| and darkens them again,
+  // checking |is_lit| after each. Returns true if both came out right.
+  static bool try_timing(G35String& lights, const G35Timing& timing,
+                         bool (*is_lit)());
+
+  // Sets every bulb one at a time, so that each frame gets tested.
+  static void fill(G35String& lights, color_t color);
+};
+
+#endif  // INCLUDE_G35_TIMING_CALIBRATOR_H
@@ -15,14 +15,12 @@
 #include <SpookyFlicker.h>
 #include <Eyes.h>
 #include <LightProgram.h>
+#include <LightProgramRegistry.h>
 #include <PumpkinChase.h>
 #include <SpookySlow.h>
 
-class HalloweenProgramGroup : public LightProgramGroup {
- public:
-  enum { ProgramCount = 5 };
-
-  virtual LightProgram* CreateProgram(G35& lights, uint8_t program_index);
-};
+typedef LightProgramRegistry<
+  Eyes, Creepers, PumpkinChase, SpookySlow,
+  SpookyFlicker> HalloweenProgramGroup;
 
 #endif  // INCLUDE_G35_HALLOWEEN_PROGRAMS_H
@@ -10,17 +10,73 @@
 
 #include <Inchworm.h>
 
-Inchworm::Inchworm(G35& g35) : LightProgram(g35), count_(0), next_worm_(0) {
-  g35_.fill_color(0, light_count_, 255, COLOR_BLACK);
-}
+Inchworm::Inchworm(G35& g35)
+  : LightProgram(g35),
+    sprites_(g35, SpriteEngine::capacity_for(light_count_, BULBS_PER_WORM)),
+    is_halloween_(false), count_(0), next_worm_(0) {}
+
+Inchworm::Inchworm(G35& g35, bool is_halloween)
+  : LightProgram(g35),
+    sprites_(g35, SpriteEngine::capacity_for(light_count_, BULBS_PER_WORM)),
+    is_halloween_(is_halloween), count_(0), next_worm_(0) {}
 
 uint32_t Inchworm::Do() {
-  for (int i = 0; i < count_; ++i) {
-    worms_[i].Do(g35_);
+  sprites_.update();
+  for (uint8_t i = 0; i < count_; ++i) {
+    steer(i);
   }
-  if (count_ < 6 && millis() > next_worm_) {
+  sprites_.draw();
+
+  uint8_t capacity = sprites_.get_capacity();
+  if (count_ < capacity && G35Clock::now() > next_worm_) {
+    color_t color;
+    if (is_halloween_) {
+      color = random_.coin() ? COLOR_GREEN : COLOR_ORANGE;
+    } else {
+      color = random_.max_color();
+    }
+    sprites_.spawn(count_, 0, 0, 0, color, SpriteEngine::FOREVER,
+                   SpriteEngine::VISIBLE);
+    sprites_.set_growth(count_, random_.between(Q8_8(0.1), Q8_8(0.6)));
     ++count_;
-    next_worm_ = millis() + 2000 + 1000 * count_;
+    // Worms set out more and more slowly, over the same minute or so however
+    // many there are.
+    next_worm_ = G35Clock::now() + 2000 + 6000UL * count_ / capacity;
   }
   return bulb_frame_;
 }
+
+// A worm's velocity and growth say all there is to know about its gait.
+// Going forward, its tail stays put while it stretches, and its head stays
+// put while it pulls its tail in; going backward, the other way around.
+void Inchworm::steer(uint8_t i) {
+  q8_8_t velocity = sprites_.get_velocity(i);
+  q8_8_t growth = sprites_.get_growth(i);
+  q8_8_t speed = growth < 0 ? -growth : growth;
+  bool is_forward = velocity > 0 || (velocity == 0 && growth > 0);
+  bool is_stretching = growth > 0;
+
+  q8_8_t length = sprites_.get_length(i);
+  if (length < UNIT * Q8_8_ONE) {
+    is_stretching = true;
+  } else if (length >= MAX_UNITS * UNIT * Q8_8_ONE) {
+    is_stretching = false;
+  }
+
+  q16_16_t position = sprites_.get_position(i);
+  if (is_forward &&
+      G35Math::to_int(position + G35Math::from_q8_8(length)) >=
+      (int16_t)light_count_ - 1) {
+    is_forward = false;
+  } else if (!is_forward && position <= 0) {
+    is_forward = true;
+  }
+
+  if (is_stretching) {
+    sprites_.set_velocity(i, is_forward ? 0 : -speed);
+    sprites_.set_growth(i, speed);
+  } else {
+    sprites_.set_velocity(i, is_forward ? speed : 0);
+    sprites_.set_growth(i, -speed);
+  }
+}
@@ -12,17 +12,36 @@
 #define INCLUDE_G35_PROGRAMS_INCHWORM_H
 
 #include <LightProgram.h>
-#include <Worm.h>
+#include <SpriteEngine.h>
 
+// Worms that inch along the string, stretching out and then pulling their
+// tails in, and turn around at the ends. A new one sets out every few
+// seconds until there's one for every BULBS_PER_WORM bulbs.
 class Inchworm : public LightProgram {
  public:
   Inchworm(G35& g35);
   uint32_t Do();
 
+  enum {
+    BULBS_PER_WORM = 8,
+    SCRATCH_BASE = SpriteEngine::BYTES_PER_SPRITE,
+    SCRATCH_PER_BULB = SpriteEngine::scratch_per_bulb(BULBS_PER_WORM)
+  };
+
+ protected:
+  Inchworm(G35& g35, bool is_halloween);
+
  private:
+  // A worm stretches until it's this many units long, and pulls in until
+  // it's shorter than one.
+  enum { UNIT = 2, MAX_UNITS = 4 };
+
+  void steer(uint8_t i);
+
+  SpriteEngine sprites_;
+  bool is_halloween_;
   uint8_t count_;
   uint32_t next_worm_;
-  Worm worms_[6];
 };
 
 #endif  // INCLUDE_G35_PROGRAMS_INCHWORM_H
@@ -12,6 +12,9 @@
 #define INCLUDE_G35_LIGHT_PROGRAMS_H
 
 #include <G35.h>
+#include <G35Clock.h>
+#include <G35Random.h>
+#include <LightProgramArena.h>
 
 // Interface for light programs.
 //
@@ -22,19 +25,66 @@ class LightProgram {
  LightProgram(G35& g35)
    : g35_(g35), light_count_(g35.get_light_count()),
     bulb_frame_(g35.get_bulb_frame()) {}
+  virtual ~LightProgram() {}
+
+  // Programs come from the current LightProgramArena if there is one, and
+  // otherwise from the heap.
+  static void* operator new(size_t size) { return allocate_scratch(size); }
+  static void operator delete(void* p) { free_scratch(p); }
 
   // Do a single slice of work. Returns the number of milliseconds before
-  // this function should be called again.
+  // this function should be called again. Programs that keep time of their
+  // own should read it from G35Clock::now() rather than millis().
   virtual uint32_t Do() = 0;
+
+  // What ProgramRunner should do when it has fallen behind this program's
+  // schedule, for example because another string's program hogged the CPU.
+  enum {
+    // Drop the missed frames and carry on at the next frame boundary.
+    SKIP_MISSED_FRAMES,
+    // Run the missed frames back to back until back on schedule. Useful for
+    // programs that must take a certain number of steps per second.
+    CATCH_UP,
+  };
+  virtual uint8_t get_late_frame_policy() { return SKIP_MISSED_FRAMES; }
+
+  // Bytes of scratch memory (see allocate_scratch()) the program takes per
+  // bulb, plus a base it takes however short the string, so that arenas can
+  // be sized to fit. Programs that use scratch memory redeclare these.
+  enum { SCRATCH_BASE = 0, SCRATCH_PER_BULB = 0 };
+
+  // For memory a program needs beyond its own members, such as per-bulb
+  // state. Call allocate_scratch() in the constructor, or from a member's
+  // constructor, so that the memory comes from the same place as the
+  // program, and free_scratch() in the destructor, and declare
+  // SCRATCH_BASE and SCRATCH_PER_BULB.
+  static void* allocate_scratch(size_t size) {
+    LightProgramArena* arena = LightProgramArena::get_current();
+    void* p = arena != NULL ? arena->allocate(size) : NULL;
+    return p != NULL ? p : malloc(size);
+  }
+  static void free_scratch(void* p) {
+    // Arena memory is all freed at once when the next program is created.
+    if (!LightProgramArena::is_arena_memory(p)) {
+      free(p);
+    }
+  }
+
  protected:
   G35& g35_;
-  uint8_t light_count_;
+  uint16_t light_count_;
   uint8_t bulb_frame_;
+  // The program's own random numbers. Use these rather than rand().
+  G35Random random_;
 };
 
 // A collection of LightProgram classes. Putting them here makes it much
 // easier on app developers because they don't have to create a switch
 // statement for every set of programs they're interested in including.
+//
+// The library's own groups are LightProgramRegistry lists, which need no
+// switch either and can be sized and combined at compile time. This interface
+// is for groups that choose programs at run time.
 class LightProgramGroup {
  public:
   virtual LightProgram* CreateProgram(G35& lights, uint8_t program_index) = 0;
@@ -0,0 +1,42 @@
+/*
+  G35: An Arduino library for GE Color Effects G-35 holiday lights.
+  Copyright © 2011 The G35 Authors. Use, modification, and distribution are
+  subject to the BSD license as described in the accompanying LICENSE file.
+
+  See README for complete attributions.
+*/
+
+#include <LightProgramArena.h>
+
+LightProgramArena* LightProgramArena::current_ = NULL;
+LightProgramArena* LightProgramArena::first_ = NULL;
+
+LightProgramArena::LightProgramArena(void* memory, size_t size)
+  : memory_(static_cast<uint8_t*>(memory)), size_(size), used_(0),
+    peak_used_(0), next_(first_) {
+  first_ = this;
+}
+
+void* LightProgramArena::allocate(size_t size) {
+  size = (size + ALIGNMENT - 1) & ~(size_t)(ALIGNMENT - 1);
+  if (size > size_ - used_) {
+    return NULL;
+  }
+  void* p = memory_ + used_;
+  used_ += size;
+  if (used_ > peak_used_) {
+    peak_used_ = used_;
+  }
+  return p;
+}
+
+// static
+bool LightProgramArena::is_arena_memory(const void* p) {
+  for (LightProgramArena* arena = first_; arena != NULL;
+       arena = arena->next_) {
+    if (arena->contains(p)) {
+      return true;
+    }
+  }
+  return false;
+}
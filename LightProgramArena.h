@@ -0,0 +1,98 @@
+/*
+  G35: An Arduino library for GE Color Effects G-35 holiday lights.
+  Copyright © 2011 The G35 Authors. Use, modification, and distribution are
+  subject to the BSD license as described in the accompanying LICENSE file.
+
+  See README for complete attributions.
+*/
+
+#ifndef INCLUDE_G35_LIGHT_PROGRAM_ARENA_H
+#define INCLUDE_G35_LIGHT_PROGRAM_ARENA_H
+
+#include <Arduino.h>
+
+// Memory for one light program at a time, set aside when the sketch starts.
+//
+// Creating a program every minute or so on a 2KB heap eventually fragments
+// it, and how long an allocation takes depends on what came before. With an
+// arena, ProgramRunner builds each program in the same block of memory, and
+// switching programs costs the same every time and can't fail partway
+// through a show.
+//
+// While ProgramRunner is creating a program, LightProgram's operator new and
+// its scratch allocations take memory from the runner's arena, so program
+// groups and sketches keep using plain new. Anything that doesn't fit comes
+// from the heap as before.
+class LightProgramArena {
+ public:
+  // Allocations are rounded up to keep this alignment.
+  enum { ALIGNMENT = alignof(long double) };
+
+  LightProgramArena(void* memory, size_t size);
+
+  // Returns |size| bytes, or NULL if the arena doesn't have room.
+  void* allocate(size_t size);
+
+  // Frees everything allocated so far.
+  void clear() { used_ = 0; }
+
+  bool contains(const void* p) const {
+    return p >= memory_ && p < memory_ + size_;
+  }
+
+  size_t get_size() const { return size_; }
+  size_t get_used() const { return used_; }
+  // The most the arena has held at once, for sizing it.
+  size_t get_peak_used() const { return peak_used_; }
+
+  // The arena that programs being created right now allocate from, or NULL
+  // if they should use the heap.
+  static LightProgramArena* get_current() { return current_; }
+
+  // Makes |arena| current for as long as the Scope exists.
+  class Scope {
+   public:
+    Scope(LightProgramArena* arena) : previous_(current_) { current_ = arena; }
+    ~Scope() { current_ = previous_; }
+
+   private:
+    LightProgramArena* previous_;
+  };
+
+  // True if |p| came from any arena rather than the heap.
+  static bool is_arena_memory(const void* p);
+
+ private:
+  uint8_t* memory_;
+  size_t size_;
+  size_t used_;
+  size_t peak_used_;
+  // Every arena, so that is_arena_memory() can check them all.
+  LightProgramArena* next_;
+
+  static LightProgramArena* current_;
+  static LightProgramArena* first_;
+};
+
+// An arena with room for |SIZE| bytes. Declare it at file scope, so that the
+// memory is set aside at compile time, and see LIGHT_PROGRAM_ARENA_SIZE().
+template <size_t SIZE>
+class StaticLightProgramArena : public LightProgramArena {
+ public:
+  StaticLightProgramArena() : LightProgramArena(memory_, SIZE) {}
+
+ private:
+  alignas(ALIGNMENT) uint8_t memory_[SIZE];
+};
+
+// Enough arena for any program in |group| (a LightProgramRegistry, or
+// anything else with MaxProgramSize, MaxScratchBase and MaxScratchPerBulb)
+// running on |light_count| bulbs, including the padding that rounding each
+// allocation up can add.
+#define LIGHT_PROGRAM_ARENA_SIZE(group, light_count)                  \
+  ((size_t)group::MaxProgramSize +                                    \
+   (size_t)group::MaxScratchBase +                                    \
+   (size_t)group::MaxScratchPerBulb * (light_count) +                 \
+   4 * LightProgramArena::ALIGNMENT)
+
+#endif  // INCLUDE_G35_LIGHT_PROGRAM_ARENA_H
@@ -0,0 +1,105 @@
+/*
+  G35: An Arduino library for GE Color Effects G-35 holiday lights.
+  Copyright © 2011 The G35 Authors. Use, modification, and distribution are
+  subject to the BSD license as described in the accompanying LICENSE file.
+
+  See README for complete attributions.
+*/
+
+#ifndef INCLUDE_G35_LIGHT_PROGRAM_REGISTRY_H
+#define INCLUDE_G35_LIGHT_PROGRAM_REGISTRY_H
+
+#include <LightProgram.h>
+
+// The largest size, alignment, base scratch memory and per-bulb scratch
+// memory among |Programs|.
+template <typename... Programs>
+struct LargestLightProgram {
+  enum { SIZE = 0, ALIGNMENT = 1, SCRATCH_BASE = 0, SCRATCH_PER_BULB = 0 };
+};
+
+template <typename Program, typename... Programs>
+struct LargestLightProgram<Program, Programs...> {
+  typedef LargestLightProgram<Programs...> Rest;
+  enum {
+    SIZE = sizeof(Program) > (size_t)Rest::SIZE ?
+      sizeof(Program) : (size_t)Rest::SIZE,
+    ALIGNMENT = alignof(Program) > (size_t)Rest::ALIGNMENT ?
+      alignof(Program) : (size_t)Rest::ALIGNMENT,
+    SCRATCH_BASE = (int)Program::SCRATCH_BASE > (int)Rest::SCRATCH_BASE ?
+      (int)Program::SCRATCH_BASE : (int)Rest::SCRATCH_BASE,
+    SCRATCH_PER_BULB =
+      (int)Program::SCRATCH_PER_BULB > (int)Rest::SCRATCH_PER_BULB ?
+      (int)Program::SCRATCH_PER_BULB : (int)Rest::SCRATCH_PER_BULB
+  };
+};
+
+// A list of LightProgram classes, fixed at compile time. For example,
+//
+//   typedef LightProgramRegistry<Cylon, Stereo, Pulse> MyPrograms;
+//   ...
+//   LightProgram* p = MyPrograms::CreateProgram(lights, 1);  // a Stereo
+//
+// CreateProgram() indexes a PROGMEM table with one entry per class rather
+// than working through a switch, and the registry knows its size and its
+// largest program, so it can size a LightProgramArena (see
+// LIGHT_PROGRAM_ARENA_SIZE()). Use LightProgramRegistryConcat to run
+// programs from several registries.
+template <typename... Programs>
+class LightProgramRegistry {
+ public:
+  enum {
+    ProgramCount = sizeof...(Programs),
+    MaxProgramSize = LargestLightProgram<Programs...>::SIZE,
+    MaxProgramAlignment = LargestLightProgram<Programs...>::ALIGNMENT,
+    MaxScratchBase = LargestLightProgram<Programs...>::SCRATCH_BASE,
+    MaxScratchPerBulb = LargestLightProgram<Programs...>::SCRATCH_PER_BULB
+  };
+
+  static_assert((size_t)MaxProgramAlignment <=
+                (size_t)LightProgramArena::ALIGNMENT,
+                "A program needs more alignment than an arena provides.");
+
+  // Indexes past the end wrap around.
+  static LightProgram* CreateProgram(G35& lights, uint8_t program_index) {
+    if (program_index >= ProgramCount) {
+      program_index %= ProgramCount;
+    }
+    Creator creator = reinterpret_cast<Creator>(
+      pgm_read_ptr(&creators_[program_index]));
+    return creator(lights);
+  }
+
+ private:
+  typedef LightProgram* (*Creator)(G35& lights);
+
+  template <typename Program>
+  static LightProgram* create(G35& lights) { return new Program(lights); }
+
+  static const Creator creators_[ProgramCount];
+};
+
+template <typename... Programs>
+const typename LightProgramRegistry<Programs...>::Creator
+LightProgramRegistry<Programs...>::creators_[ProgramCount] PROGMEM = {
+  &LightProgramRegistry<Programs...>::template create<Programs>...
+};
+
+// The programs of all the |Registries|, in order, as a single registry in
+// |type|.
+template <typename... Registries>
+struct LightProgramRegistryConcat;
+
+template <typename Registry>
+struct LightProgramRegistryConcat<Registry> {
+  typedef Registry type;
+};
+
+template <typename... First, typename... Second, typename... Rest>
+struct LightProgramRegistryConcat<LightProgramRegistry<First...>,
+                                  LightProgramRegistry<Second...>, Rest...> {
+  typedef typename LightProgramRegistryConcat<
+    LightProgramRegistry<First..., Second...>, Rest...>::type type;
+};
+
+#endif  // INCLUDE_G35_LIGHT_PROGRAM_REGISTRY_H
@@ -13,6 +13,7 @@
 #define INCLUDE_G35_MEO_PROGRAMS_H
 
 #include <LightProgram.h>
+#include <LightProgramRegistry.h>
 /* #include <Chasing.h> */
 /* #include <ColorPhasing.h> */
 /* #include <Dither.h> */
@@ -23,11 +24,9 @@
 /* #include <SineWave.h> */
 /* #include <Whites.h> */
 
-class MEOProgramGroup : public LightProgramGroup {
- public:
-  enum { ProgramCount = 9 };
-
-  virtual LightProgram* CreateProgram(G35& lights, uint8_t program_index);
-};
+// Only Rainbow has been ported so far. The rest are MEOWhites,
+// MEORandomStrobe, MEOSimplexNoise, MEOSineWave, MEOChasing, MEOColorPhasing,
+// MEODither and MEOOscillate.
+typedef LightProgramRegistry<Rainbow> MEOProgramGroup;
 
 #endif  // INCLUDE_G35_MEO_PROGRAMS_H
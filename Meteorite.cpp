@@ -12,32 +12,42 @@
 
 Meteorite::Meteorite(G35& g35)
   : LightProgram(g35),
-    position_(g35_.get_last_light() + TAIL) {}
+    sprites_(g35, SpriteEngine::capacity_for(light_count_,
+                                             BULBS_PER_METEOR)) {
+  // Spaced out, so that they don't all arrive at once.
+  for (uint8_t i = 0; i < sprites_.get_capacity(); ++i) {
+    launch(i, -(int16_t)i * BULBS_PER_METEOR);
+  }
+}
 
 uint32_t Meteorite::Do() {
-  if (position_ == static_cast<int16_t>(g35_.get_last_light()) + TAIL) {
-    position_ = 0;
-    uint8_t r, g, b;
-    r = rand() > (RAND_MAX / 2) ? 15 : 0;
-    g = rand() > (RAND_MAX / 2) ? 15 : 0;
-    b = rand() > (RAND_MAX / 2) ? 15 : 0;
-    if (r == 0 && g == 0 && b == 0) {
-      r = 15;
-      g = 15;
-      b = 15;
+  sprites_.update();
+  for (uint8_t i = 0; i < sprites_.get_capacity(); ++i) {
+    if (!sprites_.is_alive(i)) {
+      launch(i, 0);
     }
-    d_ = rand() % bulb_frame_ + 5;
-    colors_[0] = COLOR(r, g, b);
-    colors_[1] = COLOR(r * 3 / 4, g * 3 / 4, b * 3 / 4);
-    colors_[2] = COLOR(r * 2 / 4, g * 2 / 4, b * 2 / 4);
-    colors_[3] = COLOR(r * 1 / 4, g * 1 / 4, b * 1 / 4);
-    colors_[4] = COLOR(r * 0 / 4, g * 0 / 4, b * 0 / 4);
   }
+  sprites_.draw();
+  return FRAME_MS;
+}
 
-  for (int i = 0; i < TAIL; ++i) {
-    int pos = position_ - i;
-    g35_.set_color_if_in_range(pos, 255, colors_[i]);
+void Meteorite::launch(uint8_t i, int16_t head) {
+  uint8_t r, g, b;
+  // One draw gives all three coin flips.
+  uint32_t bits = random_.next();
+  r = bits & 0x80000000 ? 15 : 0;
+  g = bits & 0x40000000 ? 15 : 0;
+  b = bits & 0x20000000 ? 15 : 0;
+  if (r == 0 && g == 0 && b == 0) {
+    r = 15;
+    g = 15;
+    b = 15;
   }
-  ++position_;
-  return d_;
+  // Somewhere from 5 to bulb_frame_ + 4 ms a bulb, as bulbs per frame.
+  uint16_t ms_per_bulb = random_.uniform(bulb_frame_) + 5;
+  q8_8_t velocity = (FRAME_MS * Q8_8_ONE) / ms_per_bulb;
+  sprites_.spawn(i, G35Math::from_int(head - (TAIL - 1)), velocity,
+                 (TAIL - 1) * Q8_8_ONE, COLOR(r, g, b), SpriteEngine::FOREVER,
+                 SpriteEngine::VISIBLE | SpriteEngine::FADE_TAIL |
+                 SpriteEngine::EXPIRE_OFF_END);
 }
@@ -12,18 +12,30 @@
 #define INCLUDE_G35_PROGRAMS_METEORITE_H
 
 #include <LightProgram.h>
+#include <SpriteEngine.h>
 
+// Meteors with fading tails shoot down the string, each at its own speed,
+// one for every BULBS_PER_METEOR bulbs.
 class Meteorite : public LightProgram {
  public:
   Meteorite(G35& g35);
   uint32_t Do();
 
+  enum {
+    BULBS_PER_METEOR = 50,
+    SCRATCH_BASE = SpriteEngine::BYTES_PER_SPRITE,
+    SCRATCH_PER_BULB = SpriteEngine::scratch_per_bulb(BULBS_PER_METEOR)
+  };
+
  private:
-  static const uint8_t TAIL = 5;
+  // Lit bulbs in a meteor, head included.
+  static const uint8_t TAIL = 4;
+  static const uint8_t FRAME_MS = 10;
+
+  // Sends meteor |i| off again from |head|.
+  void launch(uint8_t i, int16_t head);
 
-  uint8_t d_;
-  int16_t position_;
-  color_t colors_[TAIL];
+  SpriteEngine sprites_;
 };
 
 #endif  // INCLUDE_G35_PROGRAMS_METEORITE_H
@@ -10,41 +10,53 @@
 
 #include <Orbit.h>
 
+#include <new>
+
 Orbit::Orbit(G35& g35)
   : LightProgram(g35),
-    should_erase_(true),
-    count_(MAX_OBJECTS),
-    light_count_(g35_.get_light_count()) {
-  set_centers();
+    sprites_(g35, SpriteEngine::capacity_for(light_count_,
+                                             BULBS_PER_ORBITER)) {
+  spawn_orbiters();
+}
+
+Orbit::~Orbit() {
+  for (uint8_t i = 0; i < sprites_.get_capacity(); ++i) {
+    orbiters_[i].~Orbiter();
+  }
+  free_scratch(orbiters_);
 }
 
 uint32_t Orbit::Do() {
-  for (int i = 0; i < count_; ++i) {
-    Orbiter *o = &orbiter_[i];
-    o->Do();
-    uint8_t x = o->x_local(light_count_, orbiter_center_[i]);
-
-    if (should_erase_ && last_x_[i] != x) {
-      g35_.set_color(last_x_[i], 255, COLOR_BLACK);
-      last_x_[i] = x;
-    }
-    g35_.set_color(x, 255, o->color());
+  // Orbiters move themselves, so the sprites only need drawing.
+  for (uint8_t i = 0; i < sprites_.get_capacity(); ++i) {
+    orbiters_[i].Do();
+    uint16_t x = orbiters_[i].x_local(light_count_, centers_[i]);
+    sprites_.set_position(i, G35Math::from_int(x));
   }
+  sprites_.draw();
   return bulb_frame_ >> 1;
 }
 
 Orbit::Orbit(G35& g35, bool should_erase)
   : LightProgram(g35),
-    should_erase_(should_erase),
-    count_(MAX_OBJECTS),
-    light_count_(g35_.get_light_count()) {
-  set_centers();
+    sprites_(g35, SpriteEngine::capacity_for(light_count_,
+                                             BULBS_PER_ORBITER)) {
+  sprites_.set_trails(!should_erase);
+  spawn_orbiters();
 }
 
-void Orbit::set_centers() {
-  for (int i = 0; i < count_; ++i) {
-    orbiter_center_[i] = rand() % light_count_;
-    last_x_[i] = 0;
+void Orbit::spawn_orbiters() {
+  uint8_t count = sprites_.get_capacity();
+  orbiters_ = static_cast<Orbiter*>(
+    allocate_scratch(count * (sizeof(Orbiter) + sizeof(uint16_t))));
+  centers_ = reinterpret_cast<uint16_t*>(orbiters_ + count);
+  // Scratch memory is raw, so each Orbiter is constructed in place.
+  for (uint8_t i = 0; i < count; ++i) {
+    new (&orbiters_[i]) Orbiter();
+    orbiters_[i].randomize(random_);
+    centers_[i] = random_.uniform(light_count_);
+    sprites_.spawn(i, 0, 0, 0, orbiters_[i].color(), SpriteEngine::FOREVER,
+                   SpriteEngine::VISIBLE);
   }
 }
 
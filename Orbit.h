@@ -13,26 +13,36 @@
 
 #include <LightProgram.h>
 #include <Orbiter.h>
+#include <SpriteEngine.h>
 
+// Orbiters swinging back and forth around random centers, one for every
+// BULBS_PER_ORBITER bulbs.
 class Orbit : public LightProgram {
  public:
   Orbit(G35& g35);
+  ~Orbit();
   uint32_t Do();
 
+  enum {
+    BULBS_PER_ORBITER = 5,
+    // The sprites, plus an Orbiter and a center for each, and at least one
+    // of each of those.
+    SCRATCH_BASE = SpriteEngine::BYTES_PER_SPRITE + sizeof(Orbiter) +
+      sizeof(uint16_t),
+    SCRATCH_PER_BULB = SpriteEngine::scratch_per_bulb(BULBS_PER_ORBITER) +
+      (sizeof(Orbiter) + sizeof(uint16_t) + BULBS_PER_ORBITER - 1) /
+      BULBS_PER_ORBITER
+  };
+
  protected:
   Orbit(G35& g35, bool should_erase);
 
  private:
-  enum { MAX_OBJECTS = 10 };
-  bool should_erase_;
-  uint8_t count_;
-  int16_t last_light_shifted_;
-  int8_t light_count_;
-  Orbiter orbiter_[MAX_OBJECTS];
-  uint8_t orbiter_center_[MAX_OBJECTS];
-  uint8_t last_x_[MAX_OBJECTS];
-
-  void set_centers();
+  void spawn_orbiters();
+
+  SpriteEngine sprites_;
+  Orbiter* orbiters_;
+  uint16_t* centers_;
 };
 
 class OrbitSmudge : public Orbit {
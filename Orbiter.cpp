@@ -11,35 +11,44 @@
 #include <Orbiter.h>
 
 Orbiter::Orbiter()
-  : radius_((float)rand() / (float)RAND_MAX),
-    angle_(2 * PI * (float)rand() / (float)RAND_MAX),
-    d_angle_(0),
-    x_(0),
-    color_(G35::max_color(rand())) {
-  const float MIN_ACTION = 0.005;
-  while (d_angle_ < MIN_ACTION && d_angle_ > -MIN_ACTION) {
-    d_angle_ = -0.02 + 0.04 * (float)rand() / (float)RAND_MAX;
-  }
-}
+  : radius_(0), angle_(0), d_angle_(0), x_(0), color_(COLOR_BLACK) {}
 
-Orbiter::Orbiter(float radius, float d_angle)
+Orbiter::Orbiter(q8_8_t radius, int16_t d_angle, color_t color)
   : radius_(radius),
     angle_(0),
     d_angle_(d_angle),
     x_(0),
-    color_(G35::max_color(rand())) {}
+    color_(color) {}
+
+void Orbiter::randomize(G35Random& random) {
+  const int16_t MIN_ACTION = ANGLE(0.005);
+  const int16_t MAX_ACTION = ANGLE(0.02);
+  radius_ = random.uniform(Q8_8_ONE + 1);
+  angle_ = random.next() >> 16;
+  d_angle_ = random.between(MIN_ACTION, MAX_ACTION);
+  if (random.coin()) {
+    d_angle_ = -d_angle_;
+  }
+  color_ = random.max_color();
+}
 
 void Orbiter::Do() {
-  x_ = sin(angle_) * radius_;
+  // sin() is at most 1.0 and the radius is a Q8.8 fraction, so the product
+  // fits without G35Math::mul().
+  x_ = (G35Math::sin(angle_) * radius_) >> 8;
   angle_ += d_angle_;
 }
 
-float Orbiter::x() {
+q16_16_t Orbiter::x() {
   return x_;
 }
 
-uint8_t Orbiter::x_local(uint8_t range, uint8_t center) {
-  return ((uint8_t)(x_ * range + center)) % range;
+uint16_t Orbiter::x_local(uint16_t range, uint16_t center) {
+  // Two bits of x_ are dropped so that the product fits in 32 bits for any
+  // range up to 16384 bulbs.
+  int32_t offset = ((x_ >> 2) * (int32_t)range) >> 14;
+  int32_t position = (offset + center) % range;
+  return position < 0 ? position + range : position;
 }
 
 color_t Orbiter::color() {
@@ -12,22 +12,33 @@
 #define INCLUDE_G35_ORBITER_H
 
 #include <G35.h>
+#include <G35Math.h>
+#include <G35Random.h>
 
 // An Orbiter doesn't know about string length. Its coordinate system is
-// [0.0, 1.0], and it's the caller's job to scale that to real-world
+// [-1.0, 1.0], and it's the caller's job to scale that to real-world
 // values.
 class Orbiter {
  public:
+  // A motionless orbiter. Call randomize() to set it going.
   Orbiter();
-  Orbiter(float radius, float d_angle);
+  // |d_angle| is how far it moves each Do(), in binary angle units (see
+  // G35Math.h).
+  Orbiter(q8_8_t radius, int16_t d_angle, color_t color);
+
+  // Picks a random radius, starting angle, speed, direction and color.
+  void randomize(G35Random& random);
+
   void Do();
-  float x();
-  uint8_t x_local(uint8_t range, uint8_t center);
+  q16_16_t x();
+  uint16_t x_local(uint16_t range, uint16_t center);
   color_t color();
 
  private:
-  float radius_, angle_, d_angle_;
-  float x_;
+  q8_8_t radius_;
+  angle_t angle_;
+  int16_t d_angle_;
+  q16_16_t x_;
   color_t color_;
 };
 
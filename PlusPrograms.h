@@ -12,6 +12,7 @@
 #define INCLUDE_G35_PLUS_PROGRAMS_H
 
 #include <LightProgram.h>
+#include <LightProgramRegistry.h>
 #include <Meteorite.h>
 #include <Twinkle.h>
 #include <RedGreenChase.h>
@@ -21,11 +22,9 @@
 #include <Stereo.h>
 #include <Inchworm.h>
 
-class PlusProgramGroup : public LightProgramGroup {
- public:
-  enum { ProgramCount = 9 };
-
-  virtual LightProgram* CreateProgram(G35& lights, uint8_t program_index);
-};
+typedef LightProgramRegistry<
+  Meteorite, Twinkle, RedGreenChase, Pulse,
+  Orbit, OrbitSmudge, Cylon, Stereo,
+  Inchworm> PlusProgramGroup;
 
 #endif  // INCLUDE_G35_PLUS_PROGRAMS_H
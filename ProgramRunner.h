@@ -11,6 +11,7 @@
 #ifndef INCLUDE_G35_PROGRAM_RUNNER_H
 #define INCLUDE_G35_PROGRAM_RUNNER_H
 
+#include <G35Stats.h>
 #include <LightProgram.h>
 
 // ProgramRunner manages a collection of LightPrograms.
@@ -31,10 +32,27 @@ class ProgramRunner {
     program_duration_seconds_(program_duration_seconds),
     program_index_(program_count_ - 1),
     next_switch_millis_(0),
+    next_do_millis_(0),
     program_creator_(program_creator),
     program_(NULL),
+    arena_(NULL),
+#if G35_STATS
+    stats_(NULL),
+#endif
     is_switch_time_based_(true) {}
 
+#if G35_STATS
+  // Starts keeping frame statistics in |stats|, which must have room for
+  // program_count entries and start out zeroed. Entry i is for program i.
+  // Print them with G35Stats::print().
+  void set_stats(G35ProgramStats* stats) { stats_ = stats; }
+#endif
+
+  // Creates programs in |arena| rather than on the heap, so that switching
+  // programs never allocates. Size it with LIGHT_PROGRAM_ARENA_SIZE(). Call
+  // this once during initialization, before the first loop().
+  void set_arena(LightProgramArena* arena) { arena_ = arena; }
+
   // Stops automatic, time-based switching, leaving you to call
   // switch_program_to() yourself to switch to specific light programs. Call
   // this once during initialization.
@@ -45,9 +63,14 @@ class ProgramRunner {
   // Calls the correct light program as often as needed (e.g., every few
   // milliseconds or however long the program defines an animation frame to be).
   // You should call this method as often as you can.
+  //
+  // Frames are scheduled against absolute deadlines, so time spent inside
+  // Do() or waiting for the next loop() doesn't stretch the program's frame
+  // rate. All comparisons survive millis() wrapping around after 49 days.
+  // Time comes from G35Clock, so a G35VirtualClock can fast-forward a show.
   void loop() {
-    uint32_t now = millis();
-    if (is_switch_time_based() && now >= next_switch_millis_) {
+    uint32_t now = G35Clock::now();
+    if (is_switch_time_based() && is_due(now, next_switch_millis_)) {
       switch_program();
     } else {
       // This is the first loop() with manual switching. We need to have some
@@ -57,14 +80,36 @@ class ProgramRunner {
         switch_program_to(0);
       }
     }
-    if (now >= next_do_millis_) {
-      next_do_millis_ = now + program_->Do();
+    if (is_due(now, next_do_millis_)) {
+#if G35_STATS
+      G35FrameRecorder recorder;
+#endif
+      uint32_t interval = program_->Do();
+#if G35_STATS
+      if (stats_ != NULL) {
+        recorder.finish(&stats_[program_index_]);
+      }
+#endif
+      schedule_next_frame(interval);
     }
   }
 
+  // Returns the G35Clock time at which loop() next has something to do,
+  // either running a frame or switching programs.
+  uint32_t get_next_deadline() {
+    if (program_ == NULL) {
+      return G35Clock::now();
+    }
+    if (is_switch_time_based() &&
+        (int32_t)(next_switch_millis_ - next_do_millis_) < 0) {
+      return next_switch_millis_;
+    }
+    return next_do_millis_;
+  }
+
   // Switches to a specific light program.
   void switch_program_to(uint8_t program_index) {
-    uint32_t now = millis();
+    uint32_t now = G35Clock::now();
     if (is_switch_time_based()) {
       next_switch_millis_ = now + (uint32_t)(program_duration_seconds_) * 1000;
     }
@@ -72,22 +117,65 @@ class ProgramRunner {
     if (program_ != NULL) {
       delete program_;
     }
+    if (arena_ != NULL) {
+      arena_->clear();
+    }
     program_index_ = program_index;
+    LightProgramArena::Scope scope(arena_);
     program_ = program_creator_(program_index_);
   }
 
   // Switches to the next light program according to the program_creator
   // method.
   void switch_program() {
-    switch_program_to(++program_index_);
-    if (program_index_ == program_count_) {
-      program_index_ = 0;
+    uint8_t program_index = program_index_ + 1;
+    if (program_index == program_count_) {
+      program_index = 0;
     }
+    switch_program_to(program_index);
   }
 
  private:
+  // If the program has fallen further behind than this, it skips frames
+  // whatever its policy.
+  enum { MAX_CATCH_UP_MILLIS = 1000 };
+
   bool is_switch_time_based() { return is_switch_time_based_; }
 
+  static bool is_due(uint32_t now, uint32_t deadline) {
+    return (int32_t)(now - deadline) >= 0;
+  }
+
+  // Moves the frame deadline along by |interval|, the number of milliseconds
+  // the program asked for after the frame that was due at the old deadline.
+  void schedule_next_frame(uint32_t interval) {
+    uint32_t now = G35Clock::now();
+    if (interval == 0) {
+      // The program wants to run again right away, which it can't be late
+      // for.
+      next_do_millis_ = now;
+      return;
+    }
+    next_do_millis_ += interval;
+    // A frame that finished just as the next one falls due made it in time.
+    if ((int32_t)(now - next_do_millis_) <= 0) {
+      return;
+    }
+#if G35_STATS
+    if (stats_ != NULL) {
+      ++stats_[program_index_].missed_deadlines;
+    }
+#endif
+    uint32_t lag = now - next_do_millis_;
+    if (program_->get_late_frame_policy() == LightProgram::CATCH_UP &&
+        lag < MAX_CATCH_UP_MILLIS) {
+      // Leave the deadline in the past, and the next loop() runs it.
+      return;
+    }
+    // The next deadline after now that's still in step with the old ones.
+    next_do_millis_ = now + interval - lag % interval;
+  }
+
   uint8_t program_count_;
   uint16_t program_duration_seconds_;
   uint8_t program_index_;
@@ -95,6 +183,10 @@ class ProgramRunner {
   uint32_t next_do_millis_;
   LightProgram* (*program_creator_)(uint8_t program_index);
   LightProgram* program_;
+  LightProgramArena* arena_;
+#if G35_STATS
+  G35ProgramStats* stats_;
+#endif
   bool is_switch_time_based_;
 };
 
@@ -0,0 +1,105 @@
+/*
+  G35: An Arduino library for GE Color Effects G-35 holiday lights.
+  Copyright © 2011 The G35 Authors. Use, modification, and distribution are
+  subject to the BSD license as described in the accompanying LICENSE file.
+
+  By Mike Tsao <github.com/sowbug>.
+
+  See README for complete attributions.
+*/
+
+#ifndef INCLUDE_G35_PROGRAM_SCHEDULER_H
+#define INCLUDE_G35_PROGRAM_SCHEDULER_H
+
+#include <ProgramRunner.h>
+
+// ProgramScheduler shares one controller among several ProgramRunners, for
+// example one per independent light string.
+//
+// Calling each runner's loop() in turn makes every runner wait for all the
+// others, however soon its own frame is due. ProgramScheduler instead always
+// services whichever runner's deadline comes first, which keeps each
+// string's frame timing as close as the hardware allows. It also keeps track
+// of how late each runner's frames were.
+class ProgramScheduler {
+ public:
+  ProgramScheduler() : runner_count_(0) {}
+
+  void AddRunner(ProgramRunner* runner) {
+    if (runner_count_ == MAX_RUNNERS) {
+      return;
+    }
+    runners_[runner_count_] = runner;
+    last_lateness_[runner_count_] = 0;
+    max_lateness_[runner_count_] = 0;
+    ++runner_count_;
+  }
+
+  // Services every runner that's due, earliest deadline first, and returns
+  // the number of milliseconds until the next one is due, or 0 if one
+  // already is. Each runner is serviced at most once a call, so a program
+  // that asks to run again at once can't keep the others waiting. If the
+  // sketch has nothing else to do, it can delay() the time returned, or with
+  // a G35VirtualClock, delay() the clock and carry on at once. Call this
+  // from your loop() instead of calling each runner's loop().
+  uint32_t loop() {
+    uint8_t serviced = 0;
+    uint8_t runner;
+    for (;;) {
+      uint32_t now = G35Clock::now();
+      int32_t until_due = find_earliest(now, serviced, &runner);
+      if (until_due > 0) {
+        break;
+      }
+      record_lateness(runner, -until_due);
+      runners_[runner]->loop();
+      serviced |= 1 << runner;
+    }
+    int32_t until_due = find_earliest(G35Clock::now(), 0, &runner);
+    return until_due > 0 ? until_due : 0;
+  }
+
+  // How late, in milliseconds, the given runner's most recent frame was,
+  // and the worst it has been.
+  uint16_t get_last_lateness(uint8_t runner) { return last_lateness_[runner]; }
+  uint16_t get_max_lateness(uint8_t runner) { return max_lateness_[runner]; }
+
+ private:
+  enum { MAX_RUNNERS = 8 };
+
+  // Finds the runner with the earliest deadline, leaving out those whose
+  // bits are set in |skip|, and returns how long until it's due. Zero or
+  // less means it's due now.
+  int32_t find_earliest(uint32_t now, uint8_t skip, uint8_t* runner) {
+    int32_t earliest = 0x7fffffff;
+    *runner = 0;
+    for (uint8_t i = 0; i < runner_count_; ++i) {
+      if (skip & (1 << i)) {
+        continue;
+      }
+      int32_t until_due = runners_[i]->get_next_deadline() - now;
+      if (until_due < earliest) {
+        earliest = until_due;
+        *runner = i;
+      }
+    }
+    return earliest;
+  }
+
+  void record_lateness(uint8_t runner, uint32_t lateness) {
+    if (lateness > 0xffff) {
+      lateness = 0xffff;
+    }
+    last_lateness_[runner] = lateness;
+    if (lateness > max_lateness_[runner]) {
+      max_lateness_[runner] = lateness;
+    }
+  }
+
+  uint8_t runner_count_;
+  ProgramRunner* runners_[MAX_RUNNERS];
+  uint16_t last_lateness_[MAX_RUNNERS];
+  uint16_t max_lateness_[MAX_RUNNERS];
+};
+
+#endif  // INCLUDE_G35_PROGRAM_SCHEDULER_H
@@ -19,7 +19,7 @@ class Pulse : public LightProgram {
   uint32_t Do();
 
  private:
-  uint8_t count_;
+  uint16_t count_;
   uint16_t sequence_;
 
   static bool pulser(uint16_t sequence, color_t& color, uint8_t& intensity);
@@ -15,8 +15,17 @@ PumpkinChase::PumpkinChase(G35& g35)
     count_(1),
     sequence_(0) {}
 
+// Indexed by orange_green()'s choice: a pumpkin, a vine and dark gaps.
+const command_t PumpkinChase::palette_[9] PROGMEM = {
+  COMMAND(255, COLOR_BLACK), COMMAND(255, COLOR_BLACK),
+  COMMAND(255, COLOR_BLACK), COMMAND(255, COLOR_ORANGE),
+  COMMAND(255, COLOR_BLACK), COMMAND(255, COLOR_BLACK),
+  COMMAND(255, COLOR_GREEN), COMMAND(255, COLOR_BLACK),
+  COMMAND(255, COLOR_BLACK),
+};
+
 uint32_t PumpkinChase::Do() {
-  g35_.fill_sequence(0, count_, sequence_, 5, 255, orange_green);
+  g35_.fill_sequence(0, count_, sequence_, 5, palette_, 9);
   if (count_ < light_count_) {
     ++count_;
   } else {
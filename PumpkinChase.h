@@ -20,7 +20,9 @@ class PumpkinChase : public LightProgram {
   static color_t orange_green(uint16_t sequence);
 
  private:
-  uint8_t count_;
+  static const command_t palette_[9];
+
+  uint16_t count_;
   uint16_t sequence_;
 };
 
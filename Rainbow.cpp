@@ -11,139 +11,96 @@
 */
 
 #include <Rainbow.h>
+#include <G35ColorTables.h>
 
 #define PATTERN_COUNT (8)
-Rainbow::Rainbow(G35& g35)
-  : LightProgram(g35), wait_(0), pattern_(rand() % PATTERN_COUNT), step_(0) {
-}
-
-uint32_t Rainbow::Do() {
-  bool fortyEight;
-  for (int i=0; i < light_count_; i++) {
-    switch (pattern_) {
-    case 0:
-      fortyEight = false;
-      g35_.fill_color(i, 1, G35::MAX_INTENSITY,
-                      Rainbow::LineRG((i + step_) % 32));
-      break;
-    case 1:
-      fortyEight = false;
-      g35_.fill_color(i, 1, G35::MAX_INTENSITY,
-                      Rainbow::LineGB((i + step_) % 32));
-      break;
-    case 2:
-      fortyEight = false;
-      g35_.fill_color(i, 1, G35::MAX_INTENSITY,
-                      Rainbow::LineBR((i + step_) % 32));
-      break;
-    case 3:
-      fortyEight = true;
-      g35_.fill_color(i, 1, G35::MAX_INTENSITY,
-                      Rainbow::Wheel((i + step_) % 48));
-      break;
-    case 4:
-      fortyEight = false;
-      g35_.fill_color(i, 1, G35::MAX_INTENSITY,
-                      Rainbow::LineRG(((i * 32 / light_count_) + step_) % 32));
-      break;
-    case 5:
-      fortyEight = false;
-      g35_.fill_color(i, 1, G35::MAX_INTENSITY,
-                      Rainbow::LineGB(((i * 32 / light_count_) + step_) % 32));
-      break;
-    case 6:
-      fortyEight = false;
-      g35_.fill_color(i, 1, G35::MAX_INTENSITY,
-                      Rainbow::LineBR(((i * 32 / light_count_) + step_) % 32));
-      break;
-    case 7:
-      fortyEight = true;
-      g35_.fill_color(i, 1, G35::MAX_INTENSITY,
-                      Rainbow::Wheel(((i * 48 / light_count_) + step_) % 48));
-      break;
-    }
-  }
-
-  // reset at end of wheel or line
-  ++step_;
-  if (((step_ == 48) && fortyEight) || ((step_ == 32) && !fortyEight)) {
-    step_ = 0;
-  }
-
-  delay(wait_);
 
-  return bulb_frame_;
-}
+// Patterns 0-3 step one entry per bulb. Patterns 4-7 use the same palettes
+// stretched to fit the whole string.
+static const color_t LINE_RG_TABLE[32] PROGMEM = {
+  G35_TABLE_16(g35_line_rg_color, 0), G35_TABLE_16(g35_line_rg_color, 16),
+};
+static const color_t LINE_GB_TABLE[32] PROGMEM = {
+  G35_TABLE_16(g35_line_gb_color, 0), G35_TABLE_16(g35_line_gb_color, 16),
+};
+static const color_t LINE_BR_TABLE[32] PROGMEM = {
+  G35_TABLE_16(g35_line_br_color, 0), G35_TABLE_16(g35_line_br_color, 16),
+};
+static const color_t WHEEL_TABLE[48] PROGMEM = {
+  G35_TABLE_16(g35_wheel_color, 0), G35_TABLE_16(g35_wheel_color, 16),
+  G35_TABLE_16(g35_wheel_color, 32),
+};
 
-uint32_t Rainbow::Wheel(uint16_t WheelPos) {
-  byte r, g, b;
-  switch (WheelPos / 16) {
+Rainbow::Rainbow(G35& g35)
+  : LightProgram(g35), wait_(0), pattern_(random_.uniform(PATTERN_COUNT)),
+    step_(0) {
+  switch (pattern_ % 4) {
   case 0:
-    r = 15 - WheelPos % 16; // red down
-    g = WheelPos % 16;       // green up
-    b = 0;                    // blue off
+    table_ = LINE_RG_TABLE;
+    period_ = 32;
     break;
   case 1:
-    g = 15 - WheelPos % 16; // green down
-    b = WheelPos % 16;       // blue up
-    r = 0;                    // red off
+    table_ = LINE_GB_TABLE;
+    period_ = 32;
     break;
   case 2:
-    b = 15 - WheelPos % 16; // blue down
-    r = WheelPos % 16;       // red up
-    g = 0;                    // green off
+    table_ = LINE_BR_TABLE;
+    period_ = 32;
     break;
-  }
-  return (COLOR(r,g,b));
-}
-
-uint32_t Rainbow::LineRG(uint16_t WheelPos) {
-  byte r, g, b;
-  switch (WheelPos / 16) {
-  case 0:
-    r = 15 - WheelPos % 16; // red down
-    g = WheelPos % 16;       // green up
-    b = 0;					// blue off
-    break;
-  case 1:
-    r = WheelPos % 16;       // red up
-    g = 15 - WheelPos % 16; // green down
-    b = 0;					// blue off
+  default:
+    table_ = WHEEL_TABLE;
+    period_ = 48;
     break;
   }
-  return (COLOR(r,g,b));
+  if (pattern_ >= 4) {
+    render_ = &Rainbow::Render<true>;
+  } else {
+    render_ = &Rainbow::Render<false>;
+  }
 }
 
-uint32_t Rainbow::LineGB(uint16_t WheelPos) {
-  byte r, g, b;
-  switch (WheelPos / 16) {
-  case 0:
-    r = 0;                    // red off
-    g = 15 - WheelPos % 16; // green down
-    b = WheelPos % 16;       // blue up
-    break;
-  case 1:
-    r = 0;                    // red off
-    g = WheelPos % 16;       // green up
-    b = 15 - WheelPos % 16; // blue down
-    break;
+uint32_t Rainbow::Do() {
+  (this->*render_)();
+
+  // reset at end of wheel or line
+  if (++step_ == period_) {
+    step_ = 0;
   }
-  return (COLOR(r,g,b));
+
+  return bulb_frame_ + wait_;
 }
 
-uint32_t Rainbow::LineBR(uint16_t WheelPos) {
-  byte r, g, b;
-  switch (WheelPos / 16) {
-  case 0:
-    r = WheelPos % 16;       // red up
-    g = 0;                    // green off
-    b = 15 - WheelPos % 16; // blue down
-    break;
-  case 1:
-    r = 15 - WheelPos % 16; // red down
-    g = 0;                    // green off
-    b = WheelPos % 16;       // blue up
-    break;
+template <bool IS_STRETCHED>
+void Rainbow::Render() {
+  // Bulb i shows entry (i * period_ / light_count_ + step_) of a stretched
+  // palette. Rather than divide for every bulb, keep the running remainder
+  // of i * period_ and move along the palette each time it passes
+  // light_count_. Unstretched palettes move exactly one entry per bulb.
+  enum { CHUNK = 16 };
+  color_t colors[CHUNK];
+  uint8_t intensities[CHUNK];
+  memset(intensities, G35::MAX_INTENSITY, sizeof(intensities));
+
+  const color_t* table = table_;
+  const uint8_t period = period_;
+  uint16_t remainder = 0;
+  uint8_t index = step_;
+  for (uint16_t begin = 0; begin < light_count_; begin += CHUNK) {
+    uint8_t chunk = light_count_ - begin < CHUNK ? light_count_ - begin : CHUNK;
+    for (uint8_t i = 0; i < chunk; ++i) {
+      colors[i] = pgm_read_word(&table[index]);
+      if (IS_STRETCHED) {
+        remainder += period;
+        while (remainder >= light_count_) {
+          remainder -= light_count_;
+          if (++index == period) {
+            index = 0;
+          }
+        }
+      } else if (++index == period) {
+        index = 0;
+      }
+    }
+    g35_.set_colors(begin, chunk, colors, intensities);
   }
-  return (COLOR(r,g,b));
 }
@@ -21,14 +21,15 @@ public:
     uint32_t Do();
 
 private:
-    uint32_t Wheel(uint16_t WheelPos);
-    uint32_t LineRG(uint16_t WheelPos);
-    uint32_t LineGB(uint16_t WheelPos);
-    uint32_t LineBR(uint16_t WheelPos);
+    // Draws one frame. Chosen at construction to suit the pattern.
+    template <bool IS_STRETCHED> void Render();
+    void (Rainbow::*render_)();
 
     uint8_t wait_;
     uint8_t pattern_;
     uint8_t step_;
+    const color_t* table_;
+    uint8_t period_;
 };
 
 #endif
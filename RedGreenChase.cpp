@@ -15,8 +15,14 @@ RedGreenChase::RedGreenChase(G35& g35)
     count_(1),
     sequence_(0) {}
 
+// Indexed by red_green()'s choice, so the chase looks just the same.
+const command_t RedGreenChase::palette_[2] PROGMEM = {
+  COMMAND(G35::MAX_INTENSITY, COLOR_GREEN),
+  COMMAND(G35::MAX_INTENSITY, COLOR_RED),
+};
+
 uint32_t RedGreenChase::Do() {
-  g35_.fill_sequence(0, count_, sequence_, 5, 255, red_green);
+  g35_.fill_sequence(0, count_, sequence_, 5, palette_, 2);
   if (count_ < light_count_) {
     ++count_;
   } else {
@@ -20,7 +20,9 @@ class RedGreenChase : public LightProgram {
   static color_t red_green(uint16_t sequence);
 
  private:
-  uint8_t count_;
+  static const command_t palette_[2];
+
+  uint16_t count_;
   uint16_t sequence_;
 };
 
@@ -11,18 +11,20 @@
 #include <SpookyFlicker.h>
 
 SpookyFlicker::SpookyFlicker(G35& g35) : LightProgram(g35) {
-  intensities_ = static_cast<uint8_t*>(malloc(light_count_ * sizeof(uint8_t)));
-  deltas_ = static_cast<int8_t*>(malloc(light_count_ * sizeof(int8_t)));
-  for (uint8_t i = 0; i < light_count_; ++i) {
-    intensities_[i] = rand();
-    deltas_[i] = rand() % 5 - 2;
+  intensities_ = static_cast<uint8_t*>(
+    allocate_scratch(light_count_ * sizeof(uint8_t)));
+  deltas_ = static_cast<int8_t*>(
+    allocate_scratch(light_count_ * sizeof(int8_t)));
+  for (uint16_t i = 0; i < light_count_; ++i) {
+    intensities_[i] = random_.next();
+    deltas_[i] = random_.between(-2, 2);
   }
   g35_.fill_color(0, light_count_, 255, COLOR_BLACK);
 }
 
 SpookyFlicker::~SpookyFlicker() {
-  free(intensities_);
-  free(deltas_);
+  free_scratch(intensities_);
+  free_scratch(deltas_);
 }
 
 uint32_t SpookyFlicker::Do() {
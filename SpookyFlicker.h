@@ -18,6 +18,9 @@ class SpookyFlicker : public LightProgram {
   SpookyFlicker(G35& g35);
   ~SpookyFlicker();
 
+  // One intensity and one delta per bulb.
+  enum { SCRATCH_PER_BULB = 2 };
+
   uint32_t Do();
 
  private:
@@ -15,12 +15,12 @@ SpookySlow::SpookySlow(G35& g35) : LightProgram(g35), remaining_(0) {
 
 uint32_t SpookySlow::Do() {
   if (remaining_ == 0) {
-    remaining_ = rand() % (light_count_ >> 3);
+    remaining_ = random_.uniform(light_count_ >> 3);
     g35_.fill_color(0, light_count_, 255, COLOR_BLACK);
   }
   if (remaining_-- > 2) {
-    g35_.set_color(rand() % light_count_, G35::MAX_INTENSITY,
-                   (rand() & 1) ? COLOR_ORANGE : COLOR_PALE_ORANGE);
+    g35_.set_color(random_.uniform(light_count_), G35::MAX_INTENSITY,
+                   random_.coin() ? COLOR_ORANGE : COLOR_PALE_ORANGE);
   }
   return 1000;
 }
@@ -0,0 +1,146 @@
+/*
+  G35: An Arduino library for GE Color Effects G-35 holiday lights.
+  Copyright © 2011 The G35 Authors. Use, modification, and distribution are
+  subject to the BSD license as described in the accompanying LICENSE file.
+
+  See README for complete attributions.
+*/
+
+#include <SpriteEngine.h>
+#include <LightProgram.h>
+
+SpriteEngine::SpriteEngine(G35& g35, uint8_t capacity)
+  : g35_(g35), light_count_(g35.get_light_count()), capacity_(capacity),
+    has_trails_(false) {
+  // Widest fields first, so that every array stays aligned.
+  uint8_t* p = static_cast<uint8_t*>(LightProgram::allocate_scratch(
+    capacity_ * BYTES_PER_SPRITE + light_count_ * BYTES_PER_BULB));
+  position_ = reinterpret_cast<q16_16_t*>(p);
+  velocity_ = reinterpret_cast<q8_8_t*>(position_ + capacity_);
+  length_ = velocity_ + capacity_;
+  growth_ = length_ + capacity_;
+  color_ = reinterpret_cast<color_t*>(growth_ + capacity_);
+  lifetime_ = reinterpret_cast<uint16_t*>(color_ + capacity_);
+  shown_ = reinterpret_cast<color_t*>(lifetime_ + capacity_);
+  next_ = shown_ + light_count_;
+  flags_ = reinterpret_cast<uint8_t*>(next_ + light_count_);
+
+  // Every sprite starts out dead, and the string dark.
+  memset(p, 0, capacity_ * BYTES_PER_SPRITE + light_count_ * BYTES_PER_BULB);
+  g35_.fill_color(0, light_count_, G35::MAX_INTENSITY, COLOR_BLACK);
+}
+
+SpriteEngine::~SpriteEngine() {
+  LightProgram::free_scratch(position_);
+}
+
+// static
+uint8_t SpriteEngine::capacity_for(uint16_t light_count,
+                                   uint8_t bulbs_per_sprite) {
+  uint16_t capacity = light_count / bulbs_per_sprite;
+  if (capacity < 1) {
+    return 1;
+  }
+  return capacity > 0xff ? 0xff : capacity;
+}
+
+void SpriteEngine::spawn(uint8_t i, q16_16_t position, q8_8_t velocity,
+                         q8_8_t length, color_t color, uint16_t lifetime,
+                         uint8_t flags) {
+  position_[i] = position;
+  velocity_[i] = velocity;
+  length_[i] = length;
+  growth_[i] = 0;
+  color_[i] = color;
+  lifetime_[i] = lifetime;
+  flags_[i] = flags;
+}
+
+void SpriteEngine::update() {
+  for (uint8_t i = 0; i < capacity_; ++i) {
+    if (lifetime_[i] == 0) {
+      continue;
+    }
+    if (lifetime_[i] != FOREVER && --lifetime_[i] == 0) {
+      continue;
+    }
+    position_[i] += G35Math::from_q8_8(velocity_[i]);
+    length_[i] += growth_[i];
+    if (length_[i] < 0) {
+      length_[i] = 0;
+    }
+    if (flags_[i] & EXPIRE_OFF_END) {
+      int16_t first = G35Math::to_int(position_[i]);
+      int16_t last = G35Math::to_int(position_[i] +
+                                     G35Math::from_q8_8(length_[i]));
+      // Only off the end it's heading for, so that a sprite can start out
+      // beyond the other one and move onto the string.
+      bool is_past_last_bulb = first >= (int16_t)light_count_;
+      bool is_before_first_bulb = last < 0;
+      if (velocity_[i] > 0 ? is_past_last_bulb :
+          velocity_[i] < 0 ? is_before_first_bulb :
+          is_past_last_bulb || is_before_first_bulb) {
+        lifetime_[i] = 0;
+      }
+    }
+  }
+}
+
+void SpriteEngine::draw() {
+  if (has_trails_) {
+    memcpy(next_, shown_, light_count_ * sizeof(color_t));
+  } else {
+    memset(next_, 0, light_count_ * sizeof(color_t));
+  }
+  for (uint8_t i = 0; i < capacity_; ++i) {
+    if (lifetime_[i] == 0 || !(flags_[i] & VISIBLE)) {
+      continue;
+    }
+    int16_t first = G35Math::to_int(position_[i]);
+    int16_t last = G35Math::to_int(position_[i] +
+                                   G35Math::from_q8_8(length_[i]));
+    if (flags_[i] & FADE_TAIL) {
+      paint_faded(first, last, velocity_[i] >= 0, color_[i]);
+    } else {
+      paint(first, last, color_[i]);
+    }
+  }
+  for (uint16_t i = 0; i < light_count_; ++i) {
+    if (next_[i] != shown_[i]) {
+      g35_.set_color(i, G35::MAX_INTENSITY, next_[i]);
+      shown_[i] = next_[i];
+    }
+  }
+}
+
+void SpriteEngine::paint(int16_t first, int16_t last, color_t color) {
+  if (first < 0) {
+    first = 0;
+  }
+  if (last >= (int16_t)light_count_) {
+    last = light_count_ - 1;
+  }
+  for (int16_t i = first; i <= last; ++i) {
+    next_[i] = color;
+  }
+}
+
+void SpriteEngine::paint_faded(int16_t first, int16_t last, bool is_forward,
+                               color_t color) {
+  // Each bulb back from the leading one loses another 1/count of the color,
+  // in Q8.8 so that only this division is needed.
+  uint16_t count = last - first + 1;
+  uint16_t step = Q8_8_ONE / count;
+  uint16_t scale = Q8_8_ONE;
+  int16_t position = is_forward ? last : first;
+  int8_t direction = is_forward ? -1 : 1;
+  for (uint16_t i = 0; i < count; ++i) {
+    if (position >= 0 && position < (int16_t)light_count_) {
+      next_[position] = COLOR(((color & 0xf) * scale) >> 8,
+                              (((color >> 4) & 0xf) * scale) >> 8,
+                              (((color >> 8) & 0xf) * scale) >> 8);
+    }
+    position += direction;
+    scale -= step;
+  }
+}
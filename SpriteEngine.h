@@ -0,0 +1,136 @@
+/*
+  G35: An Arduino library for GE Color Effects G-35 holiday lights.
+  Copyright © 2011 The G35 Authors. Use, modification, and distribution are
+  subject to the BSD license as described in the accompanying LICENSE file.
+
+  See README for complete attributions.
+*/
+
+#ifndef INCLUDE_G35_SPRITE_ENGINE_H
+#define INCLUDE_G35_SPRITE_ENGINE_H
+
+#include <G35.h>
+#include <G35Math.h>
+
+// Small colored objects that move along a string: worms, eyes, meteors and
+// the like.
+//
+// A sprite covers the bulbs from its position to its position plus its
+// length, so a sprite of length 0 lights one bulb. Each frame, update()
+// moves every sprite by its velocity and grows it by its growth, and draw()
+// paints them all into a frame of its own before sending anything. Where
+// sprites overlap, the later one wins, and a bulb a sprite has left goes
+// dark, so each bulb is written at most once a frame, and only if it
+// changed.
+//
+// Sprites are kept as one array per field rather than one object each, so
+// that update() and draw() walk memory in order. All the arrays and both
+// frames come from one scratch allocation, made in the owning program's
+// constructor (see LightProgram::allocate_scratch()).
+class SpriteEngine {
+ public:
+  // Takes over the whole string and turns it off. |capacity| is how many
+  // sprites there are; none is alive until spawn()ed.
+  SpriteEngine(G35& g35, uint8_t capacity);
+  ~SpriteEngine();
+
+  // A lifetime that never runs out.
+  enum { FOREVER = 0xffff };
+
+  // Sprite flags.
+  enum {
+    // Drawn. A live sprite without it is hidden, but still moves.
+    VISIBLE = 1,
+    // Dims toward the end that trails its direction of travel.
+    FADE_TAIL = 2,
+    // Dies once it has moved entirely off the end of the string it's
+    // heading for. One that isn't moving dies off either end.
+    EXPIRE_OFF_END = 4,
+  };
+
+  // Scratch bytes per sprite, and per bulb for the frames.
+  enum {
+    BYTES_PER_SPRITE = sizeof(q16_16_t) + 4 * sizeof(q8_8_t) +
+      sizeof(color_t) + sizeof(uint16_t) + sizeof(uint8_t),
+    BYTES_PER_BULB = 2 * sizeof(color_t),
+  };
+
+  // A program's SCRATCH_PER_BULB when it has an engine with one sprite for
+  // every |bulbs_per_sprite| bulbs. capacity_for() never gives fewer than
+  // one sprite, however short the string, so the program's SCRATCH_BASE
+  // needs BYTES_PER_SPRITE as well.
+  static constexpr int scratch_per_bulb(uint8_t bulbs_per_sprite) {
+    return BYTES_PER_BULB +
+      (BYTES_PER_SPRITE + bulbs_per_sprite - 1) / bulbs_per_sprite;
+  }
+
+  // One sprite for every |bulbs_per_sprite| bulbs, but at least one.
+  static uint8_t capacity_for(uint16_t light_count, uint8_t bulbs_per_sprite);
+
+  uint8_t get_capacity() const { return capacity_; }
+
+  // Brings sprite |i| to life, replacing whatever it was. Its growth is 0.
+  void spawn(uint8_t i, q16_16_t position, q8_8_t velocity, q8_8_t length,
+             color_t color, uint16_t lifetime, uint8_t flags);
+
+  bool is_alive(uint8_t i) const { return lifetime_[i] != 0; }
+
+  // In bulbs.
+  q16_16_t get_position(uint8_t i) const { return position_[i]; }
+  void set_position(uint8_t i, q16_16_t position) { position_[i] = position; }
+
+  // In bulbs per update().
+  q8_8_t get_velocity(uint8_t i) const { return velocity_[i]; }
+  void set_velocity(uint8_t i, q8_8_t velocity) { velocity_[i] = velocity; }
+
+  // In bulbs. Never negative.
+  q8_8_t get_length(uint8_t i) const { return length_[i]; }
+  void set_length(uint8_t i, q8_8_t length) { length_[i] = length; }
+
+  // In bulbs per update().
+  q8_8_t get_growth(uint8_t i) const { return growth_[i]; }
+  void set_growth(uint8_t i, q8_8_t growth) { growth_[i] = growth; }
+
+  color_t get_color(uint8_t i) const { return color_[i]; }
+  void set_color(uint8_t i, color_t color) { color_[i] = color; }
+
+  // In update()s. A sprite dies when this reaches 0.
+  uint16_t get_lifetime(uint8_t i) const { return lifetime_[i]; }
+  void set_lifetime(uint8_t i, uint16_t lifetime) { lifetime_[i] = lifetime; }
+
+  uint8_t get_flags(uint8_t i) const { return flags_[i]; }
+  void set_flags(uint8_t i, uint8_t flags) { flags_[i] = flags; }
+
+  // With trails, a bulb keeps the last color drawn on it instead of going
+  // dark when its sprite moves on.
+  void set_trails(bool has_trails) { has_trails_ = has_trails; }
+
+  // Moves and grows every live sprite, and counts down lifetimes.
+  void update();
+
+  // Sends the bulbs that changed since the last draw().
+  void draw();
+
+ private:
+  void paint(int16_t first, int16_t last, color_t color);
+  void paint_faded(int16_t first, int16_t last, bool is_forward,
+                   color_t color);
+
+  G35& g35_;
+  uint16_t light_count_;
+  uint8_t capacity_;
+  bool has_trails_;
+
+  q16_16_t* position_;
+  q8_8_t* velocity_;
+  q8_8_t* length_;
+  q8_8_t* growth_;
+  color_t* color_;
+  uint16_t* lifetime_;
+  // What the string shows, and the frame being drawn.
+  color_t* shown_;
+  color_t* next_;
+  uint8_t* flags_;
+};
+
+#endif  // INCLUDE_G35_SPRITE_ENGINE_H
@@ -10,39 +10,41 @@
 
 #include <Stereo.h>
 
+// A quarter of the string lights up at rest, and the three waves share the
+// rest of the half equally.
 Stereo::Stereo(G35& g35) : LightProgram(g35),
-                           light_count_(g35_.get_light_count()),
-                           half_light_count_((float)light_count_ / 2.0),
-                           level0_(half_light_count_ * 0.5),
-                           level1_(half_light_count_ * 0.1666),
-                           level2_(half_light_count_ * 0.1666),
-                           level3_(half_light_count_ * 0.1666),
-                           step_(0), peak_(0) {
+                           level0_((q16_16_t)light_count_ << 14),
+                           level1_(level0_ / 3),
+                           level2_(level0_ / 3),
+                           level3_(level0_ / 3),
+                           angle1_(0), angle2_(0), angle3_(0), peak_(0) {
   g35_.fill_color(0, light_count_, 255, COLOR_BLACK);
 }
 
 uint32_t Stereo::Do() {
-  float wave = level0_ +
-    sin(step_) * level1_ +
-    sin(step_ * .7) * level2_ +
-    sin(step_ * .3) * level3_;
+  q16_16_t wave = level0_ +
+    G35Math::mul(G35Math::sin(angle1_), level1_) +
+    G35Math::mul(G35Math::sin(angle2_), level2_) +
+    G35Math::mul(G35Math::sin(angle3_), level3_);
   if (wave > peak_) {
     peak_ = wave;
   } else {
-    peak_ *= 0.99;
+    peak_ = G35Math::mul(peak_, Q16_16(0.99));
   }
-  uint8_t i = wave;
+  uint16_t i = G35Math::to_int(wave);
   while (i--) {
     g35_.set_color(i, 255, COLOR_GREEN);
     g35_.set_color(light_count_ - i, 255, COLOR_GREEN);
   }
-  uint8_t halfway = g35_.get_halfway_point();
-  uint8_t peak_i = peak_;
-  for (i = wave; i < halfway; ++i) {
+  uint16_t halfway = g35_.get_halfway_point();
+  uint16_t peak_i = G35Math::to_int(peak_);
+  for (i = G35Math::to_int(wave); i < halfway; ++i) {
     uint8_t color = i == peak_i ? COLOR_RED : COLOR_BLACK;
     g35_.set_color(i, 255, color);
     g35_.set_color(light_count_ - i, 255, color);
   }
-  step_ += 0.4;
+  angle1_ += ANGLE(0.4);
+  angle2_ += ANGLE(0.4 * 0.7);
+  angle3_ += ANGLE(0.4 * 0.3);
   return bulb_frame_;
 }
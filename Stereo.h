@@ -11,6 +11,7 @@
 #ifndef INCLUDE_G35_PROGRAMS_STEREO_H
 #define INCLUDE_G35_PROGRAMS_STEREO_H
 
+#include <G35Math.h>
 #include <LightProgram.h>
 
 // Stereo was inspired by SparkFun's "FAKE MUSIC!" demo for their
@@ -21,10 +22,10 @@ class Stereo : public LightProgram {
   uint32_t Do();
 
  private:
-  const uint8_t light_count_;
-  const float half_light_count_;
-  const float level0_, level1_, level2_, level3_;
-  float step_, peak_;
+  const q16_16_t level0_, level1_, level2_, level3_;
+  // The three waves turn at different rates.
+  angle_t angle1_, angle2_, angle3_;
+  q16_16_t peak_;
 };
 
 #endif  // INCLUDE_G35_PROGRAMS_STEREO_H
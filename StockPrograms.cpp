@@ -10,6 +10,27 @@
 
 #include <StockPrograms.h>
 
+// G35::rainbow_color() and G35::max_color() as commands, for the chases.
+static const command_t RAINBOW_PALETTE[G35::RB_COUNT] PROGMEM = {
+  COMMAND(G35::MAX_INTENSITY, COLOR_RED),
+  COMMAND(G35::MAX_INTENSITY, COLOR_ORANGE),
+  COMMAND(G35::MAX_INTENSITY, COLOR_YELLOW),
+  COMMAND(G35::MAX_INTENSITY, COLOR_GREEN),
+  COMMAND(G35::MAX_INTENSITY, COLOR_BLUE),
+  COMMAND(G35::MAX_INTENSITY, COLOR_INDIGO),
+  COMMAND(G35::MAX_INTENSITY, COLOR_VIOLET),
+};
+
+static const command_t MAX_COLOR_PALETTE[7] PROGMEM = {
+  COMMAND(G35::MAX_INTENSITY, COLOR_RED),
+  COMMAND(G35::MAX_INTENSITY, COLOR_GREEN),
+  COMMAND(G35::MAX_INTENSITY, COLOR_BLUE),
+  COMMAND(G35::MAX_INTENSITY, COLOR_CYAN),
+  COMMAND(G35::MAX_INTENSITY, COLOR_MAGENTA),
+  COMMAND(G35::MAX_INTENSITY, COLOR_YELLOW),
+  COMMAND(G35::MAX_INTENSITY, COLOR_WHITE),
+};
+
 SteadyWhite::SteadyWhite(G35& g35)
   : LightProgram(g35), intensity_(0) {
   g35_.fill_color(0, light_count_, 0, COLOR_WHITE);
@@ -32,8 +53,8 @@ uint32_t CrossOverWave::Do() {
     color_a_ = 0;
     color_b_ = 0;
     while (color_a_ == color_b_) {
-      color_a_ = G35::max_color(rand());
-      color_b_ = G35::max_color(rand());
+      color_a_ = random_.max_color();
+      color_b_ = random_.max_color();
     }
   }
   g35_.set_color(x_, G35::MAX_INTENSITY, color_a_);
@@ -50,7 +71,7 @@ uint32_t ForwardWave::Do() {
     x_ = 0;
     color_t old_color = color_;
     do {
-      color_ = G35::max_color(rand());
+      color_ = random_.max_color();
     } while (old_color == color_);
   }
   g35_.set_color(x_, G35::MAX_INTENSITY, color_);
@@ -62,8 +83,8 @@ ChasingRainbow::ChasingRainbow(G35& g35)
   : LightProgram(g35), count_(1), sequence_(0) {}
 
 uint32_t ChasingRainbow::Do() {
-  g35_.fill_sequence(0, count_, sequence_, 1, G35::MAX_INTENSITY,
-                     G35::rainbow_color);
+  g35_.fill_sequence(0, count_, sequence_, 1, RAINBOW_PALETTE,
+                     G35::RB_COUNT);
   if (count_ < light_count_) {
     ++count_;
   } else {
@@ -74,7 +95,7 @@ uint32_t ChasingRainbow::Do() {
 
 AlternateDirectionalWave::AlternateDirectionalWave(G35& g35)
   : LightProgram(g35), x_(0), x_target_(light_count_),
-    x_other_target_(-1), direction_(1), color_(G35::max_color(rand())) {}
+    x_other_target_(-1), direction_(1), color_(random_.max_color()) {}
 
 uint32_t AlternateDirectionalWave::Do() {
   g35_.set_color(x_, G35::MAX_INTENSITY, color_);
@@ -88,7 +109,7 @@ uint32_t AlternateDirectionalWave::Do() {
     x_other_target_ = t;
     color_t old_color = color_;
     do {
-      color_ = G35::max_color(rand());
+      color_ = random_.max_color();
     } while (old_color == color_);
     return 1000;
   }
@@ -102,7 +123,7 @@ uint32_t FadeInFadeOutSolidColors::Do() {
   if (intensity_ == 0) {
     color_t new_color = color_;
     do {
-      color_ = G35::max_color(rand());
+      color_ = random_.max_color();
     } while (new_color == color_);
 
     g35_.broadcast_intensity(0);
@@ -128,12 +149,12 @@ uint32_t BidirectionalWave::Do() {
   if (x_ == g35_.get_halfway_point()) {
     x_ = 0;
     do {
-      color_a_ = G35::max_color(rand());
-      color_b_ = G35::max_color(rand());
+      color_a_ = random_.max_color();
+      color_b_ = random_.max_color();
     } while (color_a_ == color_b_);
     do {
-      color_c_ = G35::max_color(rand());
-      color_d_ = G35::max_color(rand());
+      color_c_ = random_.max_color();
+      color_d_ = random_.max_color();
     } while (color_c_ == color_d_);
   }
   g35_.set_color(x_, G35::MAX_INTENSITY, color_a_);
@@ -150,8 +171,7 @@ ChasingSolidColors::ChasingSolidColors(G35& g35)
   : LightProgram(g35), count_(1), sequence_(0) {}
 
 uint32_t ChasingSolidColors::Do() {
-  g35_.fill_sequence(0, count_, sequence_, 5, G35::MAX_INTENSITY,
-                     G35::max_color);
+  g35_.fill_sequence(0, count_, sequence_, 5, MAX_COLOR_PALETTE, 7);
   if (count_ < light_count_) {
     ++count_;
   } else {
@@ -169,7 +189,7 @@ uint32_t FadeInFadeOutMultiColors::Do() {
     if (intensity_++ == 0) {
       // We mask off the last two bits so that the color segments are aligned
       // from scene to scene.
-      g35_.fill_sequence(rand() & 0x7ffc, 4, 0, G35::max_color);
+      g35_.fill_sequence(random_.next() & 0x7ffc, 4, 0, G35::max_color);
     }
     if (intensity_ == G35::MAX_INTENSITY) {
       state_ = 1;
@@ -204,7 +224,7 @@ uint32_t RandomSparkling::Do() {
     state_ = 0;
   }
   if (state_ == 0) {
-    g35_.fill_random_max(0, light_count_, G35::MAX_INTENSITY);
+    g35_.fill_random_max(0, light_count_, G35::MAX_INTENSITY, random_);
     return 1000;
   }
   g35_.fill_color(0, light_count_, G35::MAX_INTENSITY, COLOR_BLACK);
@@ -215,8 +235,7 @@ ChasingMultiColors::ChasingMultiColors(G35& g35)
   : LightProgram(g35), count_(1), sequence_(0) {}
 
 uint32_t ChasingMultiColors::Do() {
-  g35_.fill_sequence(0, count_, sequence_, 1, G35::MAX_INTENSITY,
-                     G35::max_color);
+  g35_.fill_sequence(0, count_, sequence_, 1, MAX_COLOR_PALETTE, 7);
   if (count_ < light_count_) {
     ++count_;
   } else {
@@ -228,9 +247,15 @@ uint32_t ChasingMultiColors::Do() {
 ChasingWhiteRedBlue::ChasingWhiteRedBlue(G35& g35)
   : LightProgram(g35), count_(1), sequence_(0) {}
 
+// Indexed by red_white_blue()'s choice.
+const command_t ChasingWhiteRedBlue::palette_[3] PROGMEM = {
+  COMMAND(G35::MAX_INTENSITY, COLOR_RED),
+  COMMAND(G35::MAX_INTENSITY, COLOR_WHITE),
+  COMMAND(G35::MAX_INTENSITY, COLOR_BLUE),
+};
+
 uint32_t ChasingWhiteRedBlue::Do() {
-  g35_.fill_sequence(0, count_, sequence_, 3, G35::MAX_INTENSITY,
-                     red_white_blue);
+  g35_.fill_sequence(0, count_, sequence_, 3, palette_, 3);
   if (count_ < light_count_) {
     ++count_;
   } else {
@@ -250,24 +275,3 @@ color_t ChasingWhiteRedBlue::red_white_blue(uint16_t sequence) {
   }
   return COLOR_BLUE;
 }
-
-LightProgram* StockProgramGroup::CreateProgram(G35& lights,
-                                               uint8_t program_index) {
-  switch (program_index % ProgramCount) {
-  case 0: return new CrossOverWave(lights);
-  case 1: return new ForwardWave(lights);
-  case 2: return new ChasingRainbow(lights);
-  case 3: return new AlternateDirectionalWave(lights);
-  case 4: return new FadeInFadeOutSolidColors(lights);
-  case 5: return new BidirectionalWave(lights);
-  case 6: return new ChasingSolidColors(lights);
-  case 7: return new FadeInFadeOutMultiColors(lights);
-  case 8: return new ChasingTwoColors(lights);
-  case 9: return new RandomSparkling(lights);
-  case 10: return new ChasingMultiColors(lights);
-  case 11: return new ChasingWhiteRedBlue(lights);
-  }
-
-  // not reached
-  return NULL;
-}
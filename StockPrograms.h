@@ -12,6 +12,7 @@
 #define INCLUDE_G35_STOCK_PROGRAMS_H
 
 #include <LightProgram.h>
+#include <LightProgramRegistry.h>
 
 // We don't count SteadyWhite because it's more of a mode than a program.
 #define STOCK_PROGRAM_COUNT (12)
@@ -31,7 +32,7 @@ class CrossOverWave : public LightProgram {
   uint32_t Do();
 
  private:
-  uint8_t x_;
+  uint16_t x_;
   color_t color_a_;
   color_t color_b_;
 };
@@ -42,7 +43,7 @@ class ForwardWave : public LightProgram {
   uint32_t Do();
 
  private:
-  uint8_t x_;
+  uint16_t x_;
   color_t color_;
 };
 
@@ -52,7 +53,7 @@ class ChasingRainbow : public LightProgram {
   uint32_t Do();
 
  private:
-  uint8_t count_;
+  uint16_t count_;
   uint16_t sequence_;
 };
 
@@ -86,7 +87,7 @@ class BidirectionalWave : public LightProgram {
   uint32_t Do();
 
  private:
-  uint8_t x_;
+  uint16_t x_;
   color_t color_a_;
   color_t color_b_;
   color_t color_c_;
@@ -99,7 +100,7 @@ class ChasingSolidColors : public LightProgram {
   uint32_t Do();
 
  private:
-  uint8_t count_;
+  uint16_t count_;
   uint16_t sequence_;
 };
 
@@ -138,7 +139,7 @@ class ChasingMultiColors : public LightProgram {
   uint32_t Do();
 
  private:
-  uint8_t count_;
+  uint16_t count_;
   uint16_t sequence_;
 };
 
@@ -149,15 +150,16 @@ class ChasingWhiteRedBlue : public LightProgram {
   static color_t red_white_blue(uint16_t sequence);
 
  private:
-  uint8_t count_;
+  static const command_t palette_[3];
+
+  uint16_t count_;
   uint16_t sequence_;
 };
 
-class StockProgramGroup : public LightProgramGroup {
- public:
-  enum { ProgramCount = 12 };
-
-  virtual LightProgram* CreateProgram(G35& lights, uint8_t program_index);
-};
+typedef LightProgramRegistry<
+  CrossOverWave, ForwardWave, ChasingRainbow, AlternateDirectionalWave,
+  FadeInFadeOutSolidColors, BidirectionalWave, ChasingSolidColors,
+  FadeInFadeOutMultiColors, ChasingTwoColors, RandomSparkling,
+  ChasingMultiColors, ChasingWhiteRedBlue> StockProgramGroup;
 
 #endif  // INCLUDE_G35_STOCK_PROGRAMS_H
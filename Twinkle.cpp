@@ -11,11 +11,11 @@
 #include <Twinkle.h>
 
 Twinkle::Twinkle(G35& g35) : LightProgram(g35) {
-  g35_.fill_random_max(0, light_count_, G35::MAX_INTENSITY);
+  g35_.fill_random_max(0, light_count_, G35::MAX_INTENSITY, random_);
 }
 
 uint32_t Twinkle::Do() {
-  g35_.set_color(rand() % light_count_, G35::MAX_INTENSITY,
-                 G35::max_color(rand()));
+  g35_.set_color(random_.uniform(light_count_), G35::MAX_INTENSITY,
+                 random_.max_color());
   return bulb_frame_;
 }
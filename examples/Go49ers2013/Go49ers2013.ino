@@ -33,7 +33,9 @@ class RedYellowChase : public LightProgram {
   static color_t color_sequence(uint16_t sequence);
 
  private:
-  uint8_t count_;
+  static const command_t palette_[2];
+
+  uint16_t count_;
   uint16_t sequence_;
 };
 
@@ -42,8 +44,14 @@ RedYellowChase::RedYellowChase(G35& g35)
     count_(1),
     sequence_(0) {}
 
+// Indexed by color_sequence()'s choice.
+const command_t RedYellowChase::palette_[2] PROGMEM = {
+  COMMAND(255, COLOR_YELLOW),
+  COMMAND(255, COLOR_RED),
+};
+
 uint32_t RedYellowChase::Do() {
-  g35_.fill_sequence(0, count_, sequence_, 5, 255, color_sequence);
+  g35_.fill_sequence(0, count_, sequence_, 5, palette_, 2);
   if (count_ < light_count_) {
     ++count_;
   } else {
@@ -90,6 +98,7 @@ uint32_t seedOut(unsigned int noOfBits) {
 void setup() {
   uint32_t seed = seedOut(32);
   randomSeed(seed);
+  G35Random::seed_all(seed);
   seed &= 0xff;
   // random() isn't very random. But this seed generator works quite well.
   while (seed--) {
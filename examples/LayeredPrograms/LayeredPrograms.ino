@@ -0,0 +1,68 @@
+// Two light programs on one string at once: the stock programs, dimmed, in
+// the background, with meteors, worms and orbiters moving over them.
+//
+// Each program draws on its own G35Compositor layer instead of the string,
+// and the compositor blends the layers and sends the string only the bulbs
+// that change.
+
+#include <G35Compositor.h>
+#include <G35String.h>
+#include <ProgramRunner.h>
+#include <ProgramScheduler.h>
+#include <PlusPrograms.h>
+#include <StockPrograms.h>
+
+// How long each program should run.
+#define PROGRAM_DURATION_SECONDS (30)
+
+#define LIGHT_COUNT (50)
+
+// Arduino pin number. Pin 13 will blink the on-board LED.
+#define G35_PIN (13)
+
+G35String lights(G35_PIN, LIGHT_COUNT);
+
+// Layer 0 for the background and layer 1 for the foreground.
+StaticG35Compositor<LIGHT_COUNT, 2> compositor(lights);
+
+typedef LightProgramRegistry<Meteorite, Orbit, Inchworm, OrbitSmudge>
+  ForegroundPrograms;
+
+LightProgram* CreateBackground(uint8_t program_index) {
+  return StockProgramGroup::CreateProgram(compositor.get_layer(0),
+                                          program_index);
+}
+
+LightProgram* CreateForeground(uint8_t program_index) {
+  return ForegroundPrograms::CreateProgram(compositor.get_layer(1),
+                                           program_index);
+}
+
+ProgramRunner background(CreateBackground, StockProgramGroup::ProgramCount,
+                         PROGRAM_DURATION_SECONDS);
+ProgramRunner foreground(CreateForeground, ForegroundPrograms::ProgramCount,
+                         PROGRAM_DURATION_SECONDS);
+
+ProgramScheduler scheduler;
+
+void setup() {
+  G35Random::seed_all(analogRead(0));
+
+  delay(50);
+  lights.enumerate();
+  delay(50);
+
+  // A quarter-strength background, so the foreground stands out.
+  compositor.get_layer(0).set_opacity(64);
+  compositor.get_layer(1).set_blend_mode(G35Blend::OVER);
+
+  scheduler.AddRunner(&background);
+  scheduler.AddRunner(&foreground);
+}
+
+void loop() {
+  uint32_t idle = scheduler.loop();
+  compositor.loop();
+  // There's nothing else to do until the next frame is due.
+  delay(idle);
+}
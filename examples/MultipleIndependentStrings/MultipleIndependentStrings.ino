@@ -4,6 +4,7 @@
 
 #include <G35String.h>
 #include <ProgramRunner.h>
+#include <ProgramScheduler.h>
 #include <StockPrograms.h>
 #include <PlusPrograms.h>
 
@@ -26,26 +27,13 @@ G35String lights_1(13, LIGHT_COUNT);
 G35String lights_2(12, LIGHT_COUNT);
 #endif
 
-const int PROGRAM_COUNT = StockProgramGroup::ProgramCount +
-  PlusProgramGroup::ProgramCount;
-
-StockProgramGroup stock_programs;
-PlusProgramGroup plus_programs;
+// Every stock program, then every Plus program.
+typedef LightProgramRegistryConcat<StockProgramGroup,
+                                   PlusProgramGroup>::type AllPrograms;
+const int PROGRAM_COUNT = AllPrograms::ProgramCount;
 
 LightProgram* CreateProgram(G35& lights, uint8_t program_index) {
-  randomSeed(rand() + analogRead(0));
-
-  if (program_index < StockProgramGroup::ProgramCount) {
-    return stock_programs.CreateProgram(lights, program_index);
-  }
-  program_index -= StockProgramGroup::ProgramCount;
-
-  if (program_index < PlusProgramGroup::ProgramCount) {
-    return plus_programs.CreateProgram(lights, program_index);
-  }
-  program_index -= PlusProgramGroup::ProgramCount;
-
-  return NULL;
+  return AllPrograms::CreateProgram(lights, program_index);
 }
 
 LightProgram* CreateProgram_1(uint8_t program_index) {
@@ -63,8 +51,11 @@ ProgramRunner runner_1(CreateProgram_1, PROGRAM_COUNT,
 ProgramRunner runner_2(CreateProgram_2, PROGRAM_COUNT,
                        PROGRAM_DURATION_SECONDS);
 
+// Runs whichever string's next frame is due first.
+ProgramScheduler scheduler;
+
 void setup() {
-  randomSeed(analogRead(0));
+  G35Random::seed_all(analogRead(0));
 
   delay(50);
   lights_1.enumerate();
@@ -73,9 +64,12 @@ void setup() {
 
   lights_1.do_test_patterns();
   lights_2.do_test_patterns();
+
+  scheduler.AddRunner(&runner_1);
+  scheduler.AddRunner(&runner_2);
 }
 
 void loop() {
-  runner_1.loop();
-  runner_2.loop();
+  // There's nothing else to do until the next frame is due.
+  delay(scheduler.loop());
 }
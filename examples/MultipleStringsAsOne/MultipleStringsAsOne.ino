@@ -16,32 +16,19 @@ G35String lights_1(13, 50);
 G35String lights_2(12, 50);
 G35StringGroup string_group;
 
-const int PROGRAM_COUNT = StockProgramGroup::ProgramCount +
-  PlusProgramGroup::ProgramCount;
-
-StockProgramGroup stock_programs;
-PlusProgramGroup plus_programs;
+// Every stock program, then every Plus program.
+typedef LightProgramRegistryConcat<StockProgramGroup,
+                                   PlusProgramGroup>::type AllPrograms;
+const int PROGRAM_COUNT = AllPrograms::ProgramCount;
 
 LightProgram* CreateProgram(uint8_t program_index) {
-  randomSeed(rand() + analogRead(0));
-
-  if (program_index < StockProgramGroup::ProgramCount) {
-    return stock_programs.CreateProgram(string_group, program_index);
-  }
-  program_index -= StockProgramGroup::ProgramCount;
-
-  if (program_index < PlusProgramGroup::ProgramCount) {
-    return plus_programs.CreateProgram(string_group, program_index);
-  }
-  program_index -= PlusProgramGroup::ProgramCount;
-
-  return NULL;
+  return AllPrograms::CreateProgram(string_group, program_index);
 }
 
 ProgramRunner runner(CreateProgram, PROGRAM_COUNT, PROGRAM_DURATION_SECONDS);
 
 void setup() {
-  randomSeed(analogRead(0));
+  G35Random::seed_all(analogRead(0));
 
   delay(50);
   lights_1.enumerate();
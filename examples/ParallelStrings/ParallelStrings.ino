@@ -0,0 +1,78 @@
+// A demonstration of several strings updated in parallel from one port.
+//
+// By Mike Tsao <http://github.com/sowbug>
+
+#include <G35ParallelPort.h>
+#include <ProgramRunner.h>
+#include <StockPrograms.h>
+#include <PlusPrograms.h>
+
+// How long each program should run.
+#define PROGRAM_DURATION_SECONDS (30)
+
+#define LIGHT_COUNT (50)
+
+// On a standard Arduino, pins 8 through 13 are all on port B. Any pins will
+// do, as long as they share a port.
+G35ParallelString lights_1(8, LIGHT_COUNT);
+G35ParallelString lights_2(9, LIGHT_COUNT);
+G35ParallelString lights_3(10, LIGHT_COUNT);
+G35ParallelString lights_4(11, LIGHT_COUNT);
+G35ParallelPort port;
+
+// Every stock program, then every Plus program.
+typedef LightProgramRegistryConcat<StockProgramGroup,
+                                   PlusProgramGroup>::type AllPrograms;
+const int PROGRAM_COUNT = AllPrograms::ProgramCount;
+
+LightProgram* CreateProgram(G35& lights, uint8_t program_index) {
+  return AllPrograms::CreateProgram(lights, program_index);
+}
+
+LightProgram* CreateProgram_1(uint8_t program_index) {
+  return CreateProgram(lights_1, program_index);
+}
+
+LightProgram* CreateProgram_2(uint8_t program_index) {
+  return CreateProgram(lights_2, (program_index + 1) % PROGRAM_COUNT);
+}
+
+LightProgram* CreateProgram_3(uint8_t program_index) {
+  return CreateProgram(lights_3, (program_index + 2) % PROGRAM_COUNT);
+}
+
+LightProgram* CreateProgram_4(uint8_t program_index) {
+  return CreateProgram(lights_4, (program_index + 3) % PROGRAM_COUNT);
+}
+
+ProgramRunner runner_1(CreateProgram_1, PROGRAM_COUNT,
+                       PROGRAM_DURATION_SECONDS);
+ProgramRunner runner_2(CreateProgram_2, PROGRAM_COUNT,
+                       PROGRAM_DURATION_SECONDS);
+ProgramRunner runner_3(CreateProgram_3, PROGRAM_COUNT,
+                       PROGRAM_DURATION_SECONDS);
+ProgramRunner runner_4(CreateProgram_4, PROGRAM_COUNT,
+                       PROGRAM_DURATION_SECONDS);
+
+void setup() {
+  G35Random::seed_all(analogRead(0));
+
+  port.AddString(&lights_1);
+  port.AddString(&lights_2);
+  port.AddString(&lights_3);
+  port.AddString(&lights_4);
+
+  delay(50);
+  port.enumerate();
+  delay(50);
+}
+
+void loop() {
+  runner_1.loop();
+  runner_2.loop();
+  runner_3.loop();
+  runner_4.loop();
+
+  // The programs above have only said what they want. This makes it so.
+  port.show();
+}
@@ -22,32 +22,25 @@
 
 G35String lights(G35_PIN, LIGHT_COUNT);
 
-const int PROGRAM_COUNT = StockProgramGroup::ProgramCount +
-  PlusProgramGroup::ProgramCount;
-
-StockProgramGroup stock_programs;
-PlusProgramGroup plus_programs;
+// Every stock program, then every Plus program.
+typedef LightProgramRegistryConcat<StockProgramGroup,
+                                   PlusProgramGroup>::type AllPrograms;
+const int PROGRAM_COUNT = AllPrograms::ProgramCount;
 
 LightProgram* CreateProgram(uint8_t program_index) {
-  randomSeed(rand() + analogRead(0));
-
-  if (program_index < StockProgramGroup::ProgramCount) {
-    return stock_programs.CreateProgram(lights, program_index);
-  }
-  program_index -= StockProgramGroup::ProgramCount;
-
-  if (program_index < PlusProgramGroup::ProgramCount) {
-    return plus_programs.CreateProgram(lights, program_index);
-  }
-  program_index -= PlusProgramGroup::ProgramCount;
-
-  return NULL;
+  return AllPrograms::CreateProgram(lights, program_index);
 }
 
 ProgramRunner runner(CreateProgram, PROGRAM_COUNT, PROGRAM_DURATION_SECONDS);
 
+// Room for the biggest program, so switching programs never touches the
+// heap.
+StaticLightProgramArena<LIGHT_PROGRAM_ARENA_SIZE(AllPrograms, LIGHT_COUNT)>
+  arena;
+
 void setup() {
-  randomSeed(analogRead(0));
+  G35Random::seed_all(analogRead(0));
+  runner.set_arena(&arena);
 
   delay(50);
   lights.enumerate();
@@ -36,11 +36,10 @@ G35String lights_2(8, 41);
 
 const int PROGRAM_COUNT = HalloweenProgramGroup::ProgramCount;
 
-HalloweenProgramGroup programs;
 G35StringGroup string_group;
 
 LightProgram* CreateProgram(uint8_t program_index) {
-  return programs.CreateProgram(string_group, program_index);
+  return HalloweenProgramGroup::CreateProgram(string_group, program_index);
 }
 
 // How long each program should run.
@@ -48,6 +47,11 @@ LightProgram* CreateProgram(uint8_t program_index) {
 
 ProgramRunner runner(CreateProgram, PROGRAM_COUNT, PROGRAM_DURATION_SECONDS);
 
+// Room for the biggest program, including SpookyFlicker's per-bulb state for
+// both strings, so switching programs never touches the heap.
+StaticLightProgramArena<LIGHT_PROGRAM_ARENA_SIZE(HalloweenProgramGroup,
+                                                 50 + 41)> arena;
+
 // http://www.utopiamechanicus.com/77/better-arduino-random-numbers/
 // We assume A0 and A1 are disconnected.
 uint32_t seedOut(unsigned int noOfBits) {
@@ -68,6 +72,7 @@ uint32_t seedOut(unsigned int noOfBits) {
 void setup() {
   uint32_t seed = seedOut(32);
   randomSeed(seed);
+  G35Random::seed_all(seed);
   seed &= 0xff;
   // random() isn't very random. But this seed generator works quite well.
   while (seed--) {
@@ -83,6 +88,8 @@ void setup() {
 
   string_group.AddString(&lights_1);
   string_group.AddString(&lights_2);
+
+  runner.set_arena(&arena);
 }
 
 void loop() {
@@ -22,27 +22,16 @@
 G35String lights_1(8, 50, 50, 0, false);
 G35String lights_2(9, 40);
 
-const int PROGRAM_COUNT = StockProgramGroup::ProgramCount +
-  PlusProgramGroup::ProgramCount;
+// Every stock program, then every Plus program.
+typedef LightProgramRegistryConcat<StockProgramGroup,
+                                   PlusProgramGroup>::type AllPrograms;
+const int PROGRAM_COUNT = AllPrograms::ProgramCount;
 
-StockProgramGroup stock_programs;
-PlusProgramGroup plus_programs;
 G35StringGroup string_group;
 
 LightProgram* CreateProgram(uint8_t program_index) {
   program_index = random() % PROGRAM_COUNT;
-
-  if (program_index < StockProgramGroup::ProgramCount) {
-    return stock_programs.CreateProgram(string_group, program_index);
-  }
-  program_index -= StockProgramGroup::ProgramCount;
-
-  if (program_index < PlusProgramGroup::ProgramCount) {
-    return plus_programs.CreateProgram(string_group, program_index);
-  }
-  program_index -= PlusProgramGroup::ProgramCount;
-
-  return NULL;
+  return AllPrograms::CreateProgram(string_group, program_index);
 }
 
 // How long each program should run.
@@ -70,6 +59,7 @@ uint32_t seedOut(unsigned int noOfBits) {
 void setup() {
   uint32_t seed = seedOut(32);
   randomSeed(seed);
+  G35Random::seed_all(seed);
   seed &= 0xff;
   // random() isn't very random. But this seed generator works quite well.
   while (seed--) {
@@ -0,0 +1,255 @@
+/*
+  G35: An Arduino library for GE Color Effects G-35 holiday lights.
+  Copyright © 2011 The G35 Authors. Use, modification, and distribution are
+  subject to the BSD license as described in the accompanying LICENSE file.
+
+  See README for complete attributions.
+*/
+
+#include <Arduino.h>
+
+#include <chrono>
+#include <stdio.h>
+
+namespace {
+
+enum {
+  PORT_COUNT = 33,  // Enough for pins 0-255, plus NOT_A_PORT.
+};
+
+volatile uint8_t port_registers[PORT_COUNT];
+uint8_t last_seen_ports[PORT_COUNT];
+HostPortListener port_listener = NULL;
+bool interrupts_disabled = false;
+
+// Time that delay() and friends have "spent" without sleeping.
+uint64_t skipped_micros = 0;
+// Whether the host's own running time is left off the clock.
+bool is_wire_time = false;
+
+HostTimerHandler timer_handler = NULL;
+uint64_t timer_deadline = 0;
+bool in_timer_handler = false;
+
+uint64_t now_micros() {
+  if (is_wire_time) {
+    return skipped_micros;
+  }
+  static const std::chrono::steady_clock::time_point start =
+    std::chrono::steady_clock::now();
+  uint64_t elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - start).count();
+  return elapsed + skipped_micros;
+}
+
+void notice_port_changes(uint64_t when) {
+  for (uint8_t port = 1; port < PORT_COUNT; ++port) {
+    uint8_t value = port_registers[port];
+    if (value != last_seen_ports[port]) {
+      if (port_listener != NULL) {
+        port_listener(port, last_seen_ports[port], value, (uint32_t)when);
+      }
+      last_seen_ports[port] = value;
+    }
+  }
+}
+
+// Runs the timer handler for every deadline up to |now|, each as though it
+// happened exactly at its deadline.
+void run_timer(uint64_t now) {
+  if (in_timer_handler || interrupts_disabled) {
+    return;
+  }
+  in_timer_handler = true;
+  while (timer_handler != NULL && timer_deadline <= now) {
+    // The handler stands in for an ISR, so interrupts are off while it runs.
+    interrupts_disabled = true;
+    uint16_t next = timer_handler();
+    interrupts_disabled = false;
+    notice_port_changes(timer_deadline);
+    if (next == 0) {
+      timer_handler = NULL;
+    } else {
+      timer_deadline += next;
+    }
+  }
+  in_timer_handler = false;
+}
+
+// Reads the clock, first letting anything that was due happen.
+uint64_t advance() {
+  uint64_t now = now_micros();
+  notice_port_changes(now);
+  run_timer(now);
+  return now;
+}
+
+}  // namespace
+
+// Like the real thing, these wrap around after about 49.7 days and 71.6
+// minutes respectively.
+uint32_t millis() {
+  return (uint32_t)(advance() / 1000);
+}
+
+uint32_t micros() {
+  return (uint32_t)advance();
+}
+
+void delay(uint32_t ms) {
+  advance();
+  skipped_micros += (uint64_t)ms * 1000;
+  advance();
+}
+
+void delayMicroseconds(unsigned int us) {
+  advance();
+  skipped_micros += us;
+  advance();
+}
+
+uint8_t digitalPinToPort(uint8_t pin) {
+  return (pin >> 3) + 1;
+}
+
+uint8_t digitalPinToBitMask(uint8_t pin) {
+  return 1 << (pin & 7);
+}
+
+volatile uint8_t* portOutputRegister(uint8_t port) {
+  return port == NOT_A_PORT ? NULL : &port_registers[port];
+}
+
+void pinMode(uint8_t pin, uint8_t mode) {
+  if (mode == INPUT_PULLUP) {
+    digitalWrite(pin, HIGH);
+  }
+}
+
+void digitalWrite(uint8_t pin, uint8_t value) {
+  volatile uint8_t* out = portOutputRegister(digitalPinToPort(pin));
+  if (value == LOW) {
+    *out &= ~digitalPinToBitMask(pin);
+  } else {
+    *out |= digitalPinToBitMask(pin);
+  }
+  notice_port_changes(now_micros());
+}
+
+int digitalRead(uint8_t pin) {
+  return (port_registers[digitalPinToPort(pin)] & digitalPinToBitMask(pin)) ?
+    HIGH : LOW;
+}
+
+int analogRead(uint8_t pin) {
+  // A floating pin: ten bits of noise.
+  return rand() & 0x3ff;
+}
+
+void noInterrupts() {
+  interrupts_disabled = true;
+}
+
+void interrupts() {
+  interrupts_disabled = false;
+  advance();
+}
+
+long random(long howbig) {
+  if (howbig == 0) {
+    return 0;
+  }
+  return random() % howbig;
+}
+
+long random(long howsmall, long howbig) {
+  if (howsmall >= howbig) {
+    return howsmall;
+  }
+  return random(howbig - howsmall) + howsmall;
+}
+
+void randomSeed(unsigned long seed) {
+  if (seed != 0) {
+    srandom(seed);
+  }
+}
+
+bool host_interrupts_disabled() {
+  return interrupts_disabled;
+}
+
+uint32_t host_wire_micros() {
+  return (uint32_t)skipped_micros;
+}
+
+void host_use_wire_time() {
+  is_wire_time = true;
+}
+
+void host_set_port_listener(HostPortListener listener) {
+  notice_port_changes(now_micros());
+  port_listener = listener;
+}
+
+void host_start_timer(HostTimerHandler handler, uint16_t micros_from_now) {
+  timer_handler = handler;
+  timer_deadline = now_micros() + micros_from_now;
+}
+
+size_t Print::print(const char* s) {
+  size_t n = 0;
+  while (*s) {
+    n += write(*s++);
+  }
+  return n;
+}
+
+size_t Print::print(char c) {
+  return write(c);
+}
+
+size_t Print::print(unsigned char n) {
+  return print((unsigned long)n);
+}
+
+size_t Print::print(int n) {
+  return print((long)n);
+}
+
+size_t Print::print(unsigned int n) {
+  return print((unsigned long)n);
+}
+
+size_t Print::print(long n) {
+  char buffer[24];
+  snprintf(buffer, sizeof(buffer), "%ld", n);
+  return print(buffer);
+}
+
+size_t Print::print(unsigned long n) {
+  char buffer[24];
+  snprintf(buffer, sizeof(buffer), "%lu", n);
+  return print(buffer);
+}
+
+size_t Print::print(double n) {
+  char buffer[32];
+  snprintf(buffer, sizeof(buffer), "%.2f", n);
+  return print(buffer);
+}
+
+size_t Print::println() {
+  return print("\r\n");
+}
+
+HardwareSerial Serial;
+
+void HardwareSerial::flush() {
+  fflush(stdout);
+}
+
+size_t HardwareSerial::write(uint8_t c) {
+  putchar(c);
+  return 1;
+}
@@ -0,0 +1,132 @@
+/*
+  G35: An Arduino library for GE Color Effects G-35 holiday lights.
+  Copyright © 2011 The G35 Authors. Use, modification, and distribution are
+  subject to the BSD license as described in the accompanying LICENSE file.
+
+  See README for complete attributions.
+*/
+
+#ifndef INCLUDE_G35_HOST_ARDUINO_H
+#define INCLUDE_G35_HOST_ARDUINO_H
+
+// A stand-in for the Arduino core, just big enough to build the library on a
+// desktop machine. Nothing here talks to real hardware. Pins remember the
+// last level written to them, analog pins return noise, and delay() and
+// delayMicroseconds() advance the clock instead of sleeping, so time spent
+// bit-banging a string is accounted for without actually being waited out.
+
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define HIGH 0x1
+#define LOW  0x0
+
+#define INPUT 0x0
+#define OUTPUT 0x1
+#define INPUT_PULLUP 0x2
+
+#define NOT_A_PORT 0
+
+#define PI 3.1415926535897932384626433832795
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+uint32_t millis();
+uint32_t micros();
+void delay(uint32_t ms);
+void delayMicroseconds(unsigned int us);
+
+// Pins are grouped eight to a port, so pin 13 is bit 5 of port 2, the way
+// the real AVR mapping would have it if every port were fully populated.
+uint8_t digitalPinToPort(uint8_t pin);
+uint8_t digitalPinToBitMask(uint8_t pin);
+volatile uint8_t* portOutputRegister(uint8_t port);
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t value);
+int digitalRead(uint8_t pin);
+int analogRead(uint8_t pin);
+
+// There's only one address space here, so program memory is ordinary memory.
+#define PROGMEM
+#define pgm_read_byte(address) (*(const uint8_t*)(address))
+#define pgm_read_word(address) (*(const uint16_t*)(address))
+#define pgm_read_dword(address) (*(const uint32_t*)(address))
+#define pgm_read_ptr(address) (*(void* const*)(address))
+
+// Serial output goes to stdout. F() strings are ordinary strings.
+#define F(string_literal) (string_literal)
+
+class Print {
+ public:
+  virtual ~Print() {}
+  virtual size_t write(uint8_t c) = 0;
+
+  size_t print(const char* s);
+  size_t print(char c);
+  size_t print(unsigned char n);
+  size_t print(int n);
+  size_t print(unsigned int n);
+  size_t print(long n);
+  size_t print(unsigned long n);
+  size_t print(double n);
+
+  template <typename T>
+  size_t println(T value) { return print(value) + println(); }
+  size_t println();
+};
+
+class HardwareSerial : public Print {
+ public:
+  void begin(unsigned long baud) {}
+  void flush();
+  virtual size_t write(uint8_t c);
+};
+
+extern HardwareSerial Serial;
+
+void noInterrupts();
+void interrupts();
+
+long random(long howbig);
+long random(long howsmall, long howbig);
+void randomSeed(unsigned long seed);
+
+// Host-only extras, for tools that want to look behind the curtain.
+
+// True between noInterrupts() and interrupts().
+bool host_interrupts_disabled();
+
+// Microseconds accumulated by delay() and delayMicroseconds() alone. Unlike
+// micros(), this ignores how long the host itself takes to run the code in
+// between, so it's the time the same code would take on a controller whose
+// instructions were free.
+uint32_t host_wire_micros();
+
+// Makes the clock count only that time, as if the host ran the code in
+// between in no time at all, so that waveforms come out the same on every
+// run however busy the host is. For tests. Call it before anything reads the
+// clock.
+void host_use_wire_time();
+
+// Called when an output port is seen to change, with the port number, its
+// old and new values, and micros() at the time of the change. Port writes
+// are plain memory writes, so changes are noticed the next time the code
+// waits for anything, reads the clock, calls digitalWrite() or returns from
+// a timer handler. That's exactly when a bit-banging routine needs them
+// noticed.
+typedef void (*HostPortListener)(uint8_t port, uint8_t previous,
+                                 uint8_t value, uint32_t micros);
+void host_set_port_listener(HostPortListener listener);
+
+// A stand-in for a hardware timer's compare interrupt. Once started, the
+// handler runs each time the clock passes its deadline, exactly on time
+// however slow the host is, but never while interrupts are off. It returns
+// the number of microseconds until it should run again, or 0 to stop.
+typedef uint16_t (*HostTimerHandler)();
+void host_start_timer(HostTimerHandler handler, uint16_t micros_from_now);
+
+#endif  // INCLUDE_G35_HOST_ARDUINO_H
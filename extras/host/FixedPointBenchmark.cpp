@@ -0,0 +1,141 @@
+/*
+  G35: An Arduino library for GE Color Effects G-35 holiday lights.
+  Copyright © 2011 The G35 Authors. Use, modification, and distribution are
+  subject to the BSD license as described in the accompanying LICENSE file.
+
+  See README for complete attributions.
+*/
+
+// Compares G35Math against the float code it replaced, for speed and for how
+// far the answers drift apart. A desktop CPU has floating-point hardware, so
+// the speed numbers flatter float compared to an AVR; the errors are the same
+// everywhere.
+
+#include <G35Math.h>
+#include <Orbiter.h>
+#include <stdio.h>
+
+#include <chrono>
+
+namespace {
+
+const int ITERATIONS = 1000000;
+
+volatile int32_t sink_int;
+volatile float sink_float;
+
+double nanoseconds_per_call(std::chrono::steady_clock::time_point start) {
+  std::chrono::duration<double, std::nano> elapsed =
+    std::chrono::steady_clock::now() - start;
+  return elapsed.count() / ITERATIONS;
+}
+
+void report(const char* name, double float_ns, double fixed_ns,
+            double max_error) {
+  printf("%-8s %10.2f %10.2f %12.6f\n", name, float_ns, fixed_ns, max_error);
+}
+
+void benchmark_sin() {
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < ITERATIONS; ++i) {
+    sink_float = sin(i * (float)(2 * PI / 65536));
+  }
+  double float_ns = nanoseconds_per_call(start);
+
+  start = std::chrono::steady_clock::now();
+  for (int i = 0; i < ITERATIONS; ++i) {
+    sink_int = G35Math::sin(i);
+  }
+  double fixed_ns = nanoseconds_per_call(start);
+
+  double max_error = 0;
+  for (int32_t angle = 0; angle < 65536; ++angle) {
+    double error = fabs(sin(angle * 2 * PI / 65536) -
+                        G35Math::sin(angle) / 65536.0);
+    if (error > max_error) {
+      max_error = error;
+    }
+  }
+  report("sin", float_ns, fixed_ns, max_error);
+}
+
+void benchmark_mul() {
+  auto start = std::chrono::steady_clock::now();
+  float product = 1;
+  for (int i = 0; i < ITERATIONS; ++i) {
+    product = product * 0.99f + 1.0f;
+  }
+  sink_float = product;
+  double float_ns = nanoseconds_per_call(start);
+
+  start = std::chrono::steady_clock::now();
+  q16_16_t fixed_product = Q16_16_ONE;
+  for (int i = 0; i < ITERATIONS; ++i) {
+    fixed_product = G35Math::mul(fixed_product, Q16_16(0.99)) + Q16_16_ONE;
+  }
+  sink_int = fixed_product;
+  double fixed_ns = nanoseconds_per_call(start);
+
+  double max_error = 0;
+  for (int i = 0; i < 10000; ++i) {
+    q16_16_t a = rand() % (200 << 16) - (100 << 16);
+    q16_16_t b = rand() % (4 << 16) - (2 << 16);
+    double error = fabs((double)a * b / 65536 / 65536 -
+                        G35Math::mul(a, b) / 65536.0);
+    if (error > max_error) {
+      max_error = error;
+    }
+  }
+  report("mul", float_ns, fixed_ns, max_error);
+}
+
+// The float Orbiter as it was, used by Cylon and Orbit. Error is measured in
+// bulbs on a 50-bulb string.
+void benchmark_orbiter() {
+  const uint16_t RANGE = 50;
+  const uint16_t CENTER = 25;
+
+  auto start = std::chrono::steady_clock::now();
+  float angle = 0;
+  for (int i = 0; i < ITERATIONS; ++i) {
+    float x = sin(angle) * 0.5f;
+    angle += 0.01f;
+    sink_int = ((uint16_t)(x * RANGE + CENTER)) % RANGE;
+  }
+  double float_ns = nanoseconds_per_call(start);
+
+  start = std::chrono::steady_clock::now();
+  Orbiter orbiter(Q8_8(0.5), ANGLE(0.01), COLOR_WHITE);
+  for (int i = 0; i < ITERATIONS; ++i) {
+    orbiter.Do();
+    sink_int = orbiter.x_local(RANGE, CENTER);
+  }
+  double fixed_ns = nanoseconds_per_call(start);
+
+  // Step sizes differ slightly once rounded to binary angles, so compare
+  // positions at the same angle rather than after the same number of steps.
+  double max_error = 0;
+  for (int32_t a = 0; a < 65536; a += 16) {
+    // The first Do() moves it to |a|, and the second reports that position.
+    Orbiter fixed(Q8_8(0.5), a, COLOR_WHITE);
+    fixed.Do();
+    fixed.Do();
+    float x = sin(a * (float)(2 * PI / 65536)) * 0.5f;
+    double error = fabs((double)(uint16_t)(x * RANGE + CENTER) -
+                        fixed.x_local(RANGE, CENTER));
+    if (error > max_error) {
+      max_error = error;
+    }
+  }
+  report("orbiter", float_ns, fixed_ns, max_error);
+}
+
+}  // namespace
+
+int main() {
+  printf("# name   float_ns   fixed_ns    max_error\n");
+  benchmark_sin();
+  benchmark_mul();
+  benchmark_orbiter();
+  return 0;
+}
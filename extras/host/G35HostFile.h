@@ -0,0 +1,46 @@
+/*
+  G35: An Arduino library for GE Color Effects G-35 holiday lights.
+  Copyright © 2011 The G35 Authors. Use, modification, and distribution are
+  subject to the BSD license as described in the accompanying LICENSE file.
+
+  See README for complete attributions.
+*/
+
+#ifndef INCLUDE_G35_HOST_FILE_H
+#define INCLUDE_G35_HOST_FILE_H
+
+// Files for the host build, mainly so that G35Recorder can write recordings
+// and G35Player can read them.
+
+#include <Arduino.h>
+#include <stdio.h>
+
+// A Print that writes to a stdio file.
+class FilePrint : public Print {
+ public:
+  FilePrint(FILE* file) : file_(file) {}
+  virtual size_t write(uint8_t c) { return fputc(c, file_) == EOF ? 0 : 1; }
+
+ private:
+  FILE* file_;
+};
+
+// A whole file mapped read-only into memory.
+class MappedFile {
+ public:
+  MappedFile();
+  ~MappedFile();
+
+  // Returns false if the file can't be opened or mapped.
+  bool Open(const char* path);
+  void Close();
+
+  const uint8_t* data() { return data_; }
+  size_t size() { return size_; }
+
+ private:
+  const uint8_t* data_;
+  size_t size_;
+};
+
+#endif  // INCLUDE_G35_HOST_FILE_H
@@ -0,0 +1,33 @@
+/*
+  G35: An Arduino library for GE Color Effects G-35 holiday lights.
+  Copyright © 2011 The G35 Authors. Use, modification, and distribution are
+  subject to the BSD license as described in the accompanying LICENSE file.
+
+  See README for complete attributions.
+*/
+
+#ifndef INCLUDE_G35_HOST_TEST_H
+#define INCLUDE_G35_HOST_TEST_H
+
+#include <stdio.h>
+
+// Just enough harness for the host tests that ctest runs, one executable
+// each. EXPECT() reports a condition that doesn't hold and carries on, and
+// main() ends with G35_TEST_RESULT(), which fails the test if any didn't.
+
+static int g35_test_failures = 0;
+
+#define EXPECT(condition)                                               \
+  do {                                                                  \
+    if (!(condition)) {                                                 \
+      fprintf(stderr, "%s:%d: expected %s\n", __FILE__, __LINE__,       \
+              #condition);                                              \
+      ++g35_test_failures;                                              \
+    }                                                                   \
+  } while (0)
+
+#define G35_TEST_RESULT()                                               \
+  (printf("%s\n", g35_test_failures == 0 ? "PASS" : "FAIL"),            \
+   g35_test_failures == 0 ? 0 : 1)
+
+#endif  // INCLUDE_G35_HOST_TEST_H
@@ -0,0 +1,88 @@
+/*
+  G35: An Arduino library for GE Color Effects G-35 holiday lights.
+  Copyright © 2011 The G35 Authors. Use, modification, and distribution are
+  subject to the BSD license as described in the accompanying LICENSE file.
+
+  See README for complete attributions.
+*/
+
+#include <G35WaveformDecoder.h>
+#include <G35Protocol.h>
+
+G35WaveformDecoder* G35WaveformDecoder::listener_ = NULL;
+
+G35WaveformDecoder::G35WaveformDecoder()
+  : bad_bit_count_(0), bad_frame_count_(0) {}
+
+G35WaveformDecoder::~G35WaveformDecoder() {
+  StopListening();
+}
+
+void G35WaveformDecoder::Listen() {
+  listener_ = this;
+  host_set_port_listener(OnPortChange);
+}
+
+void G35WaveformDecoder::StopListening() {
+  if (listener_ == this) {
+    host_set_port_listener(NULL);
+    listener_ = NULL;
+  }
+}
+
+void G35WaveformDecoder::Clear() {
+  for (int i = 0; i < PIN_COUNT; ++i) {
+    pins_[i].commands.clear();
+  }
+  bad_bit_count_ = 0;
+  bad_frame_count_ = 0;
+}
+
+// static
+void G35WaveformDecoder::OnPortChange(uint8_t port, uint8_t previous,
+                                      uint8_t value, uint32_t now) {
+  uint8_t changed = previous ^ value;
+  for (uint8_t bit = 0; bit < 8; ++bit) {
+    if (changed & (1 << bit)) {
+      uint8_t pin = ((port - 1) << 3) + bit;
+      listener_->OnEdge(pin, (value >> bit) & 1, now);
+    }
+  }
+}
+
+void G35WaveformDecoder::OnEdge(uint8_t pin_number, uint8_t level,
+                                uint32_t now) {
+  Pin& pin = pins_[pin_number];
+  pin.level = level;
+
+  if (pin.bit_count < 0) {
+    if (level == HIGH) {
+      if (!pin.commands.empty() && now - pin.frame_end < MIN_QUIET) {
+        ++bad_frame_count_;
+      }
+      pin.bit_count = 0;
+      pin.frame = 0;
+      pin.frame_start = now;
+    }
+  } else if (level == LOW) {
+    if (pin.bit_count == G35_FRAME_BITS) {
+      Command command;
+      command.bulb = pin.frame >> 20;
+      command.intensity = pin.frame >> 12;
+      command.color = pin.frame & 0xfff;
+      command.start_micros = pin.frame_start;
+      pin.commands.push_back(command);
+      pin.bit_count = -1;
+      pin.frame_end = now;
+    }
+  } else {
+    // A rising edge ends the low part of a bit, which is all that counts.
+    uint32_t low = now - pin.last_edge;
+    if (low < MIN_LOW || low > MAX_LOW) {
+      ++bad_bit_count_;
+    }
+    pin.frame = (pin.frame << 1) | (low >= LONG_LOW ? 1 : 0);
+    ++pin.bit_count;
+  }
+  pin.last_edge = now;
+}
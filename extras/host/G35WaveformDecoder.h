@@ -0,0 +1,86 @@
+/*
+  G35: An Arduino library for GE Color Effects G-35 holiday lights.
+  Copyright © 2011 The G35 Authors. Use, modification, and distribution are
+  subject to the BSD license as described in the accompanying LICENSE file.
+
+  See README for complete attributions.
+*/
+
+#ifndef INCLUDE_G35_HOST_WAVEFORM_DECODER_H
+#define INCLUDE_G35_HOST_WAVEFORM_DECODER_H
+
+#include <G35.h>
+
+#include <vector>
+
+// G35WaveformDecoder watches the host's simulated output ports and turns the
+// waveform on each pin back into the commands a bulb would have received.
+// It's how host-side code checks that G35String, G35ParallelPort and friends
+// put the right bits on the wire with the right timing.
+//
+// Only one decoder can listen at a time.
+class G35WaveformDecoder {
+ public:
+  struct Command {
+    uint8_t bulb;
+    uint8_t intensity;
+    color_t color;
+    uint32_t start_micros;  // micros() at the start of the frame.
+  };
+
+  G35WaveformDecoder();
+  ~G35WaveformDecoder();
+
+  // Starts and stops watching the ports.
+  void Listen();
+  void StopListening();
+
+  // Commands decoded so far from |pin|, oldest first.
+  const std::vector<Command>& commands(uint8_t pin) {
+    return pins_[pin].commands;
+  }
+
+  // Bits whose timing was too far off for a bulb to read reliably, and
+  // frames that started before the previous one had ended.
+  uint32_t bad_bit_count() { return bad_bit_count_; }
+  uint32_t bad_frame_count() { return bad_frame_count_; }
+
+  void Clear();
+
+ private:
+  enum {
+    PIN_COUNT = 256,
+    // Bits are judged against these, in microseconds. A bulb doesn't care
+    // much about anything but whether the low part is short or long.
+    MIN_LOW = 5,
+    LONG_LOW = 15,
+    MAX_LOW = 30,
+    MIN_QUIET = 30,
+  };
+
+  struct Pin {
+    Pin() : level(LOW), bit_count(-1), frame(0), last_edge(0),
+            frame_end(0) {}
+
+    uint8_t level;
+    // -1 when idle, otherwise the number of bits received in this frame.
+    int8_t bit_count;
+    uint32_t frame;
+    uint32_t frame_start;
+    uint32_t last_edge;
+    uint32_t frame_end;
+    std::vector<Command> commands;
+  };
+
+  static void OnPortChange(uint8_t port, uint8_t previous, uint8_t value,
+                           uint32_t now);
+  void OnEdge(uint8_t pin, uint8_t level, uint32_t now);
+
+  static G35WaveformDecoder* listener_;
+
+  Pin pins_[PIN_COUNT];
+  uint32_t bad_bit_count_;
+  uint32_t bad_frame_count_;
+};
+
+#endif  // INCLUDE_G35_HOST_WAVEFORM_DECODER_H
@@ -0,0 +1,199 @@
+/*
+  G35: An Arduino library for GE Color Effects G-35 holiday lights.
+  Copyright © 2011 The G35 Authors. Use, modification, and distribution are
+  subject to the BSD license as described in the accompanying LICENSE file.
+
+  See README for complete attributions.
+*/
+
+// Runs every light program in the stock, Plus, Halloween and MEO groups on
+// simulated strings of several lengths, in virtual time, and reports what
+// each costs.
+//
+//   ProgramBenchmark [SECONDS]
+//
+// Each program runs for SECONDS (default 60) of show time per string length.
+// Output is one line per program and length, after a header line starting
+// with '#', with columns separated by spaces:
+//
+//   group index lights frames: which program, on how many bulbs, and how many
+//     times Do() ran.
+//   writes_per_s: bulb commands that would go out on the wire, per second of
+//     show. Writes that don't change a bulb aren't counted, as G35String
+//     doesn't send them.
+//   avg_wire_us max_wire_us: time those writes would hold the wire per
+//     frame, at G35_FRAME_MICROS each.
+//   overruns: frames whose wire time plus CPU time exceeded the interval the
+//     program asked for, so that on a board it would fall behind.
+//   avg_cpu_us max_cpu_us: host CPU time per Do(). An AVR is far slower, so
+//     compare these between programs and between builds, not with intervals.
+
+#include <G35Protocol.h>
+#include <HalloweenPrograms.h>
+#include <MEOPrograms.h>
+#include <PlusPrograms.h>
+#include <StockPrograms.h>
+#include <stdio.h>
+
+#include <chrono>
+
+namespace {
+
+const uint16_t LIGHT_COUNTS[] = { 25, 36, 50, 100, 500 };
+
+// A string of any length that counts what a G35String would send.
+class SimulatedString : public G35 {
+ public:
+  SimulatedString(uint16_t light_count)
+    : writes_(0),
+      colors_(new color_t[light_count]),
+      intensities_(new uint8_t[light_count]) {
+    light_count_ = light_count;
+    invalidate();
+  }
+  ~SimulatedString() {
+    delete[] colors_;
+    delete[] intensities_;
+  }
+
+  virtual uint16_t get_light_count() { return light_count_; }
+
+  virtual void set_color(uint16_t bulb, uint8_t intensity, color_t color) {
+    if (bulb >= light_count_) {
+      return;
+    }
+    if (intensity > MAX_INTENSITY) {
+      intensity = MAX_INTENSITY;
+    }
+    if (intensities_[bulb] == intensity && colors_[bulb] == color) {
+      return;
+    }
+    intensities_[bulb] = intensity;
+    colors_[bulb] = color;
+    ++writes_;
+  }
+
+  // A fill is a single broadcast, as on a G35String. A black one only turns
+  // the intensity down to 0, so the bulbs keep their colors.
+  virtual bool fill_all(uint8_t intensity, color_t color) {
+    if (color == COLOR_BLACK) {
+      for (uint16_t i = 0; i < light_count_; ++i) {
+        if (intensities_[i] != UNKNOWN_INTENSITY) {
+          intensities_[i] = 0;
+        }
+      }
+      ++writes_;
+      return true;
+    }
+    if (intensity > MAX_INTENSITY) {
+      intensity = MAX_INTENSITY;
+    }
+    memset(intensities_, intensity, light_count_);
+    for (uint16_t i = 0; i < light_count_; ++i) {
+      colors_[i] = color;
+    }
+    ++writes_;
+    return true;
+  }
+
+  virtual void broadcast_intensity(uint8_t intensity) {
+    invalidate();
+    ++writes_;
+  }
+
+  uint32_t get_writes() { return writes_; }
+
+ protected:
+  // Unused, since broadcast_intensity() is overridden.
+  virtual uint8_t get_broadcast_bulb() { return 0; }
+
+ private:
+  enum { UNKNOWN_INTENSITY = 0xff };
+
+  void invalidate() { memset(intensities_, UNKNOWN_INTENSITY, light_count_); }
+
+  uint32_t writes_;
+  color_t* colors_;
+  uint8_t* intensities_;
+};
+
+struct Result {
+  uint32_t frames;
+  uint64_t writes;
+  uint32_t max_wire_us;
+  uint32_t overruns;
+  double cpu_us;
+  double max_cpu_us;
+};
+
+Result run(LightProgram* (*create)(G35&, uint8_t), uint8_t index,
+           uint16_t light_count, uint32_t duration_ms) {
+  // The same random numbers and the same clock on every run, so that results
+  // can be compared from build to build.
+  G35Random::seed_all(1);
+  G35VirtualClock clock;
+  G35Clock::set_current(&clock);
+
+  SimulatedString lights(light_count);
+  LightProgram* program = create(lights, index);
+  Result result = Result();
+  while (clock.millis() < duration_ms) {
+    uint32_t writes = lights.get_writes();
+    std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
+    uint32_t interval = program->Do();
+    std::chrono::duration<double, std::micro> cpu =
+      std::chrono::steady_clock::now() - start;
+
+    uint32_t wire_us = (lights.get_writes() - writes) * G35_FRAME_MICROS;
+    ++result.frames;
+    result.writes += lights.get_writes() - writes;
+    result.cpu_us += cpu.count();
+    if (cpu.count() > result.max_cpu_us) {
+      result.max_cpu_us = cpu.count();
+    }
+    if (wire_us > result.max_wire_us) {
+      result.max_wire_us = wire_us;
+    }
+    if (wire_us + cpu.count() > interval * 1000.0) {
+      ++result.overruns;
+    }
+    // As in G35Recorder::record(), a program that asks to run again at once
+    // still has to let time pass.
+    clock.delay(interval == 0 ? 1 : interval);
+  }
+  delete program;
+  G35Clock::set_current(NULL);
+  return result;
+}
+
+template <typename Group>
+void benchmark_group(const char* name, uint32_t duration_ms) {
+  for (uint8_t i = 0; i < Group::ProgramCount; ++i) {
+    for (size_t l = 0; l < sizeof(LIGHT_COUNTS) / sizeof(LIGHT_COUNTS[0]);
+         ++l) {
+      Result r = run(Group::CreateProgram, i, LIGHT_COUNTS[l], duration_ms);
+      printf("%s %u %u %u %.1f %.1f %u %u %.2f %.2f\n", name, i,
+             LIGHT_COUNTS[l], r.frames, r.writes * 1000.0 / duration_ms,
+             (double)r.writes * G35_FRAME_MICROS / r.frames, r.max_wire_us,
+             r.overruns, r.cpu_us / r.frames, r.max_cpu_us);
+    }
+  }
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  uint32_t seconds = argc > 1 ? atoi(argv[1]) : 60;
+  if (seconds == 0) {
+    fprintf(stderr, "usage: %s [SECONDS]\n", argv[0]);
+    return 1;
+  }
+  printf("# group index lights frames writes_per_s avg_wire_us max_wire_us "
+         "overruns avg_cpu_us max_cpu_us\n");
+  benchmark_group<StockProgramGroup>("stock", seconds * 1000);
+  benchmark_group<PlusProgramGroup>("plus", seconds * 1000);
+  benchmark_group<HalloweenProgramGroup>("halloween", seconds * 1000);
+  benchmark_group<MEOProgramGroup>("meo", seconds * 1000);
+  return 0;
+}
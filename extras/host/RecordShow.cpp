@@ -0,0 +1,96 @@
+/*
+  G35: An Arduino library for GE Color Effects G-35 holiday lights.
+  Copyright © 2011 The G35 Authors. Use, modification, and distribution are
+  subject to the BSD license as described in the accompanying LICENSE file.
+
+  See README for complete attributions.
+*/
+
+// Records one of the library's light programs for G35Player.
+//
+//   RecordShow PROGRAM LIGHT_COUNT SECONDS OUTPUT [ARRAY_NAME]
+//
+// PROGRAM counts through the stock, Plus, Halloween and MEO programs in that
+// order. Without ARRAY_NAME, OUTPUT gets the raw recording, ready for
+// MappedFile. With it, OUTPUT is C++ source defining a PROGMEM array of that
+// name, to build into a sketch.
+
+#include <G35HostFile.h>
+#include <G35Recorder.h>
+#include <HalloweenPrograms.h>
+#include <MEOPrograms.h>
+#include <PlusPrograms.h>
+#include <StockPrograms.h>
+
+#include <vector>
+
+namespace {
+
+typedef LightProgramRegistryConcat<StockProgramGroup, PlusProgramGroup,
+                                   HalloweenProgramGroup,
+                                   MEOProgramGroup>::type AllPrograms;
+
+class BufferPrint : public Print {
+ public:
+  virtual size_t write(uint8_t c) {
+    bytes.push_back(c);
+    return 1;
+  }
+  std::vector<uint8_t> bytes;
+};
+
+void write_array(FILE* file, const char* name,
+                 const std::vector<uint8_t>& bytes) {
+  fprintf(file, "// Made by RecordShow. Play it with\n"
+          "// G35Player(lights, %s, sizeof(%s)).\n", name, name);
+  fprintf(file, "const uint8_t %s[] PROGMEM = {", name);
+  for (size_t i = 0; i < bytes.size(); ++i) {
+    fprintf(file, "%s0x%02x,", i % 12 == 0 ? "\n  " : " ", bytes[i]);
+  }
+  fprintf(file, "\n};\n");
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  if (argc != 5 && argc != 6) {
+    fprintf(stderr,
+            "usage: %s PROGRAM LIGHT_COUNT SECONDS OUTPUT [ARRAY_NAME]\n"
+            "PROGRAM is 0 to %d.\n", argv[0], AllPrograms::ProgramCount - 1);
+    return 1;
+  }
+  int program_index = atoi(argv[1]);
+  int light_count = atoi(argv[2]);
+  uint32_t seconds = atoi(argv[3]);
+  if (program_index < 0 || program_index >= AllPrograms::ProgramCount ||
+      light_count <= 0) {
+    fprintf(stderr, "bad program or light count\n");
+    return 1;
+  }
+
+  // Record in virtual time: quicker than the host shim's clock, and the
+  // same on every run.
+  G35VirtualClock clock;
+  G35Clock::set_current(&clock);
+
+  BufferPrint buffer;
+  G35Recorder recorder(light_count, buffer);
+  LightProgram* program = AllPrograms::CreateProgram(recorder, program_index);
+  recorder.record(*program, seconds * 1000);
+  recorder.end();
+  delete program;
+
+  FILE* file = fopen(argv[4], "wb");
+  if (file == NULL) {
+    perror(argv[4]);
+    return 1;
+  }
+  if (argc == 6) {
+    write_array(file, argv[5], buffer.bytes);
+  } else {
+    fwrite(buffer.bytes.data(), 1, buffer.bytes.size(), file);
+  }
+  fclose(file);
+  fprintf(stderr, "%u bytes\n", (unsigned)buffer.bytes.size());
+  return 0;
+}
@@ -0,0 +1,109 @@
+/*
+  G35: An Arduino library for GE Color Effects G-35 holiday lights.
+  Copyright © 2011 The G35 Authors. Use, modification, and distribution are
+  subject to the BSD license as described in the accompanying LICENSE file.
+
+  See README for complete attributions.
+*/
+
+// Records light programs with G35Recorder, plays the recordings back onto
+// another recorder with G35Player, and checks that the second recording
+// comes out byte for byte the same as the first. Also plays recordings that
+// are cut short or have bad headers.
+
+#include <G35HostTest.h>
+#include <G35Player.h>
+#include <G35Recorder.h>
+#include <G35Recording.h>
+#include <StockPrograms.h>
+
+#include <vector>
+
+namespace {
+
+enum {
+  LIGHT_COUNT = 50,
+  DURATION_MS = 20000,
+};
+
+class BufferPrint : public Print {
+ public:
+  virtual size_t write(uint8_t c) {
+    bytes.push_back(c);
+    return 1;
+  }
+  std::vector<uint8_t> bytes;
+};
+
+std::vector<uint8_t> Play(const std::vector<uint8_t>& recording, size_t size,
+                          bool* is_valid) {
+  BufferPrint buffer;
+  G35Recorder recorder(LIGHT_COUNT, buffer);
+  G35Player player(recorder, recording.data(), size);
+  *is_valid = player.is_valid();
+  recorder.record(player, DURATION_MS);
+  recorder.end();
+  return buffer.bytes;
+}
+
+void TestRoundTrip(uint8_t program_index) {
+  BufferPrint buffer;
+  G35Recorder recorder(LIGHT_COUNT, buffer);
+  LightProgram* program =
+    StockProgramGroup::CreateProgram(recorder, program_index);
+  recorder.record(*program, DURATION_MS);
+  recorder.end();
+  delete program;
+
+  bool is_valid;
+  EXPECT(Play(buffer.bytes, buffer.bytes.size(), &is_valid) == buffer.bytes);
+  EXPECT(is_valid);
+}
+
+void TestCutShort() {
+  BufferPrint buffer;
+  G35Recorder recorder(LIGHT_COUNT, buffer);
+  LightProgram* program = StockProgramGroup::CreateProgram(recorder, 0);
+  recorder.record(*program, 1000);
+  recorder.end();
+  delete program;
+
+  // Every length, so that some stop partway through a command. The copy is
+  // exactly that long, so reading past it would be reading past the end of
+  // the vector.
+  for (size_t size = 0; size < buffer.bytes.size(); ++size) {
+    std::vector<uint8_t> cut(buffer.bytes.begin(),
+                             buffer.bytes.begin() + size);
+    bool is_valid;
+    Play(cut, cut.size(), &is_valid);
+    EXPECT(is_valid == (size >= G35_RECORDING_HEADER_SIZE));
+  }
+}
+
+void TestBadLightCount() {
+  std::vector<uint8_t> recording = {
+    'G', '3', '5', G35_RECORDING_VERSION, 0, 0, G35_RECORDING_END,
+  };
+  bool is_valid;
+  Play(recording, recording.size(), &is_valid);
+  EXPECT(!is_valid);
+  recording[4] = 0xff;
+  recording[5] = 0xff;
+  Play(recording, recording.size(), &is_valid);
+  EXPECT(!is_valid);
+}
+
+}  // namespace
+
+int main() {
+  // Record in virtual time, which is quicker and the same on every run.
+  G35VirtualClock clock;
+  G35Clock::set_current(&clock);
+
+  for (uint8_t i = 0; i < StockProgramGroup::ProgramCount; ++i) {
+    TestRoundTrip(i);
+  }
+  TestCutShort();
+  TestBadLightCount();
+  return G35_TEST_RESULT();
+}
@@ -0,0 +1,216 @@
+/*
+  G35: An Arduino library for GE Color Effects G-35 holiday lights.
+  Copyright © 2011 The G35 Authors. Use, modification, and distribution are
+  subject to the BSD license as described in the accompanying LICENSE file.
+
+  See README for complete attributions.
+*/
+
+// Drives a G35String, synchronously and from G35AsyncTransmitter's queue,
+// and a G35ParallelPort on the host, and checks that the waveforms on their
+// pins decode to exactly the commands they were given.
+
+#include <G35AsyncTransmitter.h>
+#include <G35HostTest.h>
+#include <G35ParallelPort.h>
+#include <G35Stats.h>
+#include <G35String.h>
+#include <G35WaveformDecoder.h>
+
+#include <vector>
+
+namespace {
+
+struct Expected {
+  uint8_t bulb;
+  uint8_t intensity;
+  color_t color;
+};
+
+void ExpectCommands(G35WaveformDecoder& decoder, uint8_t pin,
+                    const std::vector<Expected>& expected) {
+  const std::vector<G35WaveformDecoder::Command>& commands =
+    decoder.commands(pin);
+  EXPECT(commands.size() == expected.size());
+  for (size_t i = 0; i < commands.size() && i < expected.size(); ++i) {
+    EXPECT(commands[i].bulb == expected[i].bulb);
+    EXPECT(commands[i].intensity == expected[i].intensity);
+    EXPECT(commands[i].color == expected[i].color);
+  }
+}
+
+void TestString() {
+  G35String lights(13, 20);
+  G35WaveformDecoder decoder;
+  decoder.Listen();
+
+  lights.set_color(0, G35::MAX_INTENSITY, COLOR_RED);
+  lights.set_color(7, 0x40, COLOR_GREEN);
+  lights.set_color(19, 0x01, COLOR(0xa, 0x5, 0xf));
+  // Already showing it, so nothing goes out.
+  lights.set_color(7, 0x40, COLOR_GREEN);
+  EXPECT(lights.fill_all(0x80, COLOR_BLUE));
+  lights.set_color(3, G35::MAX_INTENSITY, COLOR_WHITE);
+  // Black is a broadcast at intensity 0, and only needs sending once.
+  EXPECT(lights.fill_all(G35::MAX_INTENSITY, COLOR_BLACK));
+  EXPECT(lights.fill_all(G35::MAX_INTENSITY, COLOR_BLACK));
+  // Dark already.
+  lights.set_color(3, 0, COLOR_WHITE);
+
+  decoder.StopListening();
+  ExpectCommands(decoder, 13, {
+    {0, G35::MAX_INTENSITY, COLOR_RED},
+    {7, 0x40, COLOR_GREEN},
+    {19, 0x01, COLOR(0xa, 0x5, 0xf)},
+    {63, 0x80, COLOR_BLUE},
+    {3, G35::MAX_INTENSITY, COLOR_WHITE},
+    {63, 0, COLOR_BLACK},
+  });
+  EXPECT(decoder.bad_bit_count() == 0);
+  EXPECT(decoder.bad_frame_count() == 0);
+}
+
+// A black fill can only be skipped when the shadow knows every bulb is dark.
+void TestBlackFillOfUnknownBulbs() {
+  G35String lights(13, 4);
+  G35ParallelString parallel_lights(6, 4);
+  G35ParallelPort port;
+  EXPECT(port.AddString(&parallel_lights));
+  G35WaveformDecoder decoder;
+  decoder.Listen();
+
+  // Nothing is known before the first write.
+  EXPECT(lights.fill_all(G35::MAX_INTENSITY, COLOR_BLACK));
+  EXPECT(parallel_lights.fill_all(G35::MAX_INTENSITY, COLOR_BLACK));
+  port.show();
+  for (uint8_t i = 0; i < 4; ++i) {
+    lights.set_color(i, G35::MAX_INTENSITY, COLOR_BLACK);
+  }
+  // Dark already.
+  EXPECT(lights.fill_all(G35::MAX_INTENSITY, COLOR_BLACK));
+  // But not once the shadow is forgotten.
+  lights.invalidate();
+  EXPECT(lights.fill_all(G35::MAX_INTENSITY, COLOR_BLACK));
+
+  decoder.StopListening();
+  ExpectCommands(decoder, 13, {
+    {63, 0, COLOR_BLACK},
+    {0, G35::MAX_INTENSITY, COLOR_BLACK},
+    {1, G35::MAX_INTENSITY, COLOR_BLACK},
+    {2, G35::MAX_INTENSITY, COLOR_BLACK},
+    {3, G35::MAX_INTENSITY, COLOR_BLACK},
+    {63, 0, COLOR_BLACK},
+  });
+  ExpectCommands(decoder, 6, {
+    {63, 0, COLOR_BLACK},
+  });
+  EXPECT(decoder.bad_bit_count() == 0);
+  EXPECT(decoder.bad_frame_count() == 0);
+}
+
+void TestParallelPort() {
+  // All on the same port, and each with different bulbs to send, so that
+  // strings drop out of the frames one by one.
+  G35ParallelString a(2, 10);
+  G35ParallelString b(3, 10);
+  G35ParallelString c(4, 10);
+  G35ParallelString d(5, 10);
+  G35ParallelPort port;
+  EXPECT(port.AddString(&a));
+  EXPECT(port.AddString(&b));
+  EXPECT(port.AddString(&c));
+  EXPECT(port.AddString(&d));
+
+  G35WaveformDecoder decoder;
+  decoder.Listen();
+
+  EXPECT(a.fill_all(G35::MAX_INTENSITY, COLOR_BLUE));
+  a.set_color(3, 0x40, COLOR_RED);
+  b.set_color(0, G35::MAX_INTENSITY, COLOR_GREEN);
+  b.set_color(7, 0x20, COLOR_MAGENTA);
+  b.set_color(9, 0x01, COLOR(0x3, 0xc, 0x6));
+  d.set_color(5, 0xcc, COLOR_YELLOW);
+  EXPECT(d.fill_all(G35::MAX_INTENSITY, COLOR_BLACK));
+  port.show();
+
+  decoder.StopListening();
+  ExpectCommands(decoder, 2, {
+    {63, G35::MAX_INTENSITY, COLOR_BLUE},
+    {3, 0x40, COLOR_RED},
+  });
+  ExpectCommands(decoder, 3, {
+    {0, G35::MAX_INTENSITY, COLOR_GREEN},
+    {7, 0x20, COLOR_MAGENTA},
+    {9, 0x01, COLOR(0x3, 0xc, 0x6)},
+  });
+  ExpectCommands(decoder, 4, {});
+  // The broadcast goes first, so bulb 5 follows it already dark.
+  ExpectCommands(decoder, 5, {
+    {63, 0, COLOR_BLACK},
+    {5, 0, COLOR_YELLOW},
+  });
+  EXPECT(decoder.bad_bit_count() == 0);
+  EXPECT(decoder.bad_frame_count() == 0);
+}
+
+// More frames than the queue holds, all sent at once.
+void TestAsync(uint8_t overflow_policy) {
+  enum { FRAME_COUNT = G35AsyncTransmitter::QUEUE_SIZE * 3 };
+  G35String lights(12, FRAME_COUNT);
+  G35AsyncTransmitter::set_overflow_policy(overflow_policy);
+  uint32_t overflows = G35AsyncTransmitter::get_overflow_count();
+#if G35_STATS
+  G35WireStats wire = G35Stats::wire;
+#endif
+  G35WaveformDecoder decoder;
+  decoder.Listen();
+
+  lights.set_async(true);
+  for (uint8_t i = 0; i < FRAME_COUNT; ++i) {
+    lights.set_color(i, i, COLOR(i & 0xf, 0xf - (i & 0xf), i >> 4));
+  }
+  G35AsyncTransmitter::flush();
+  EXPECT(G35AsyncTransmitter::get_queue_depth() == 0);
+  lights.set_async(false);
+
+  decoder.StopListening();
+  EXPECT(decoder.bad_bit_count() == 0);
+  EXPECT(decoder.bad_frame_count() == 0);
+  overflows = G35AsyncTransmitter::get_overflow_count() - overflows;
+  EXPECT(overflows > 0);
+  const std::vector<G35WaveformDecoder::Command>& commands =
+    decoder.commands(12);
+  if (overflow_policy == G35AsyncTransmitter::BLOCK_WHEN_FULL) {
+    EXPECT(commands.size() == FRAME_COUNT);
+  } else {
+    // Nothing drains the queue until something waits, so the first
+    // QUEUE_SIZE frames are all that get through.
+    EXPECT(commands.size() == G35AsyncTransmitter::QUEUE_SIZE);
+    EXPECT(commands.size() == FRAME_COUNT - overflows);
+  }
+  for (size_t i = 0; i < commands.size(); ++i) {
+    EXPECT(commands[i].bulb == i);
+    EXPECT(commands[i].intensity == i);
+    EXPECT(commands[i].color == COLOR(i & 0xf, 0xf - (i & 0xf), i >> 4));
+  }
+#if G35_STATS
+  EXPECT(G35Stats::wire.bulbs_written - wire.bulbs_written ==
+         commands.size());
+  EXPECT(G35Stats::wire.bulbs_dropped - wire.bulbs_dropped ==
+         FRAME_COUNT - commands.size());
+#endif
+}
+
+}  // namespace
+
+int main() {
+  // Without this, the host being busy could stretch a bit past what the
+  // decoder accepts.
+  host_use_wire_time();
+  TestString();
+  TestBlackFillOfUnknownBulbs();
+  TestParallelPort();
+  TestAsync(G35AsyncTransmitter::BLOCK_WHEN_FULL);
+  TestAsync(G35AsyncTransmitter::DROP_WHEN_FULL);
+  return G35_TEST_RESULT();
+}
@@ -0,0 +1,22 @@
+/*
+  G35: An Arduino library for GE Color Effects G-35 holiday lights.
+  Copyright © 2011 The G35 Authors. Use, modification, and distribution are
+  subject to the BSD license as described in the accompanying LICENSE file.
+
+  See README for complete attributions.
+*/
+
+// The Arduino core's main(), for running example sketches on the host.
+
+#include <Arduino.h>
+
+void setup();
+void loop();
+
+int main() {
+  setup();
+  for (;;) {
+    loop();
+  }
+  return 0;
+}